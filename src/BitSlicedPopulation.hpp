@@ -0,0 +1,290 @@
+//=================================================================================================
+//                  Copyright (C) 2018 Alain Lanthier - All Rights Reserved
+//                  License: MIT License    See LICENSE.md for the full license.
+//                  Original code 2017 Olivier Mallet (MIT License)
+//=================================================================================================
+
+#ifndef BITSLICEDPOPULATION_HPP
+#define BITSLICEDPOPULATION_HPP
+
+namespace galgo {
+
+//=================================================================================================
+
+// index of lowest bit set (x != 0)
+inline int TrailingZeros(uint64_t x)
+{
+#if defined(__GNUC__) || defined(__clang__)
+   return __builtin_ctzll(x);
+#else
+   int n = 0;
+   while ((x & 1) == 0) { x >>= 1; ++n; }
+   return n;
+#endif
+}
+
+/*-------------------------------------------------------------------------------------------------*/
+
+// transpose 64x64 bit matrix in place: bit j of a[i] <-> bit i of a[j]
+inline void Transpose64(uint64_t* a)
+{
+   uint64_t m = 0x00000000FFFFFFFFULL;
+   for (int j = 32; j != 0; j >>= 1, m ^= (m << j)) {
+      for (int k = 0; k < 64; k = ((k | j) + 1) & ~j) {
+         uint64_t t = ((a[k] >> j) ^ a[k | j]) & m;
+         a[k] ^= (t << j);
+         a[k | j] ^= t;
+      }
+   }
+}
+
+/*-------------------------------------------------------------------------------------------------*/
+
+// Population of binary chromosomes stored transposed (bit-sliced): one slice per chromosome bit,
+// each 64 bits word of a slice holding that bit for 64 chromosomes. Bulk operators (SPM, UXO) and
+// counting kernels then work on 64 chromosomes per instruction.
+// Selection still works on the usual per-chromosome view: load() and store() convert between both.
+template <typename T>
+class BitSlicedPopulation
+{
+public:
+   // nullary constructor
+   BitSlicedPopulation() {}
+   // constructor, all bits set to 0
+   BitSlicedPopulation(int nbchr, int nbbit);
+
+   // copy bits of chromosomes into bit-sliced population (resized to pop size)
+   void load(const std::vector<CHR<T>>& pop);
+   // copy bits back into existing chromosomes (they must be evaluated again afterwards)
+   void store(std::vector<CHR<T>>& pop) const;
+
+   // get bit of chromosome chr
+   bool getBit(int chr, int bit) const;
+   // flip bit of chromosome chr
+   void flipBit(int chr, int bit);
+
+   // single point mutation of chromosomes [first...size-1], each bit flipped with probability mutrate
+   void SPM(double mutrate, int first = 0);
+   // uniform cross-over of chromosomes pairs (x[i], y[i]) into (u[i], v[i])
+   static void UXO(const BitSlicedPopulation<T>& x, const BitSlicedPopulation<T>& y, BitSlicedPopulation<T>& u, BitSlicedPopulation<T>& v);
+
+   // number of bits set in each chromosome
+   void popcount(std::vector<int>& ones) const;
+   // sum of weights w[bit] of bits set in each chromosome
+   void weighted(const std::vector<double>& w, std::vector<double>& sum) const;
+
+   // return number of chromosomes
+   int size() const { return nbchr; }
+   // return number of bits per chromosome
+   int nbbit() const { return nbit; }
+   // return slice of given bit (nbblock() words)
+   const uint64_t* slice(int bit) const { return words.data() + (size_t)bit * nbblk; }
+   uint64_t* slice(int bit) { return words.data() + (size_t)bit * nbblk; }
+   // return number of 64 chromosomes blocks
+   int nbblock() const { return nbblk; }
+
+private:
+   int nbchr = 0;                  // number of chromosomes
+   int nbit = 0;                   // number of bits per chromosome
+   int nbblk = 0;                  // number of 64 chromosomes blocks
+   std::vector<uint64_t> words;    // words[bit * nbblk + block], chromosome block * 64 + j in bit j (unused bits are 0)
+};
+
+/*-------------------------------------------------------------------------------------------------*/
+
+// constructor
+template <typename T>
+BitSlicedPopulation<T>::BitSlicedPopulation(int nbchr, int nbbit)
+   : nbchr(nbchr), nbit(nbbit), nbblk((nbchr + 63) / 64)
+{
+   words.assign((size_t)nbit * nbblk, 0);
+}
+
+/*-------------------------------------------------------------------------------------------------*/
+
+// copy bits of chromosomes into bit-sliced population
+// each block of 64 chromosomes is packed (64 bits words) then transposed 64x64 bits at a time
+template <typename T>
+void BitSlicedPopulation<T>::load(const std::vector<CHR<T>>& pop)
+{
+   nbchr = (int)pop.size();
+   nbit = nbchr > 0 ? pop[0]->size() : 0;
+   nbblk = (nbchr + 63) / 64;
+   words.assign((size_t)nbit * nbblk, 0);
+
+   const int nbword = (nbit + 63) / 64;
+   std::vector<uint64_t> packed((size_t)64 * (nbword + 1), 0);
+   uint64_t tile[64];
+
+   for (int b = 0; b < nbblk; ++b) {
+      int n = std::min(64, nbchr - b * 64);
+      for (int j = 0; j < n; ++j) {
+         PackBits(pop[b * 64 + j]->getBits(), packed.data() + (size_t)j * (nbword + 1));
+      }
+      for (int w = 0; w < nbword; ++w) {
+         for (int j = 0; j < 64; ++j) {
+            tile[j] = j < n ? packed[(size_t)j * (nbword + 1) + w] : 0;
+         }
+         Transpose64(tile);
+         // chromosome bit 64 * w + c was packed in bit 63 - c
+         int m = std::min(64, nbit - w * 64);
+         for (int c = 0; c < m; ++c) {
+            words[(size_t)(w * 64 + c) * nbblk + b] = tile[63 - c];
+         }
+      }
+   }
+}
+
+/*-------------------------------------------------------------------------------------------------*/
+
+// copy bits back into existing chromosomes
+template <typename T>
+void BitSlicedPopulation<T>::store(std::vector<CHR<T>>& pop) const
+{
+   if ((int)pop.size() != nbchr) {
+      throw std::invalid_argument("Error: in class galgo::BitSlicedPopulation<T>, population size does not match, please adjust.");
+   }
+
+   const int nbword = (nbit + 63) / 64;
+   std::string bits(nbit, '0');
+   std::vector<uint64_t> packed((size_t)64 * nbword, 0);
+   uint64_t tile[64];
+
+   for (int b = 0; b < nbblk; ++b) {
+      int n = std::min(64, nbchr - b * 64);
+      for (int w = 0; w < nbword; ++w) {
+         int m = std::min(64, nbit - w * 64);
+         for (int c = 0; c < 64; ++c) {
+            tile[63 - c] = c < m ? words[(size_t)(w * 64 + c) * nbblk + b] : 0;
+         }
+         Transpose64(tile);
+         for (int j = 0; j < n; ++j) {
+            packed[(size_t)j * nbword + w] = tile[j];
+         }
+      }
+      for (int j = 0; j < n; ++j) {
+         const uint64_t* p = packed.data() + (size_t)j * nbword;
+         for (int i = 0; i < nbit; ++i) {
+            bits[i] = (char)('0' + ((p[i >> 6] >> (63 - (i & 63))) & 1));
+         }
+         pop[b * 64 + j]->setBits(bits);
+      }
+   }
+}
+
+/*-------------------------------------------------------------------------------------------------*/
+
+// get bit of chromosome chr
+template <typename T>
+inline bool BitSlicedPopulation<T>::getBit(int chr, int bit) const
+{
+   return (slice(bit)[chr >> 6] >> (chr & 63)) & 1;
+}
+
+// flip bit of chromosome chr
+template <typename T>
+inline void BitSlicedPopulation<T>::flipBit(int chr, int bit)
+{
+   slice(bit)[chr >> 6] ^= uint64_t(1) << (chr & 63);
+}
+
+/*-------------------------------------------------------------------------------------------------*/
+
+// single point mutation: same distribution as SPM() bit by bit, but the gap between 2 flipped bits
+// is drawn from a geometric distribution (one random draw per flipped bit instead of per bit)
+template <typename T>
+void BitSlicedPopulation<T>::SPM(double mutrate, int first)
+{
+   const int n = nbchr - first;
+   if (mutrate <= 0.0 || n <= 0 || nbit == 0) return;
+
+   const int64_t total = (int64_t)nbit * n;
+   if (mutrate >= 1.0) {
+      for (int64_t pos = 0; pos < total; ++pos) flipBit(first + (int)(pos % n), (int)(pos / n));
+      return;
+   }
+
+   std::geometric_distribution<int64_t> gap(mutrate);
+   for (int64_t pos = gap(rng); pos < total; pos += gap(rng) + 1) {
+      flipBit(first + (int)(pos % n), (int)(pos / n));
+   }
+}
+
+/*-------------------------------------------------------------------------------------------------*/
+
+// uniform cross-over, one random word choosing parent bit of 64 pairs at once
+template <typename T>
+void BitSlicedPopulation<T>::UXO(const BitSlicedPopulation<T>& x, const BitSlicedPopulation<T>& y, BitSlicedPopulation<T>& u, BitSlicedPopulation<T>& v)
+{
+   if (x.nbchr != y.nbchr || x.nbit != y.nbit) {
+      throw std::invalid_argument("Error: in class galgo::BitSlicedPopulation<T>, cross-over parents populations must have same dimensions, please adjust.");
+   }
+   if (u.nbchr != x.nbchr || u.nbit != x.nbit) u = BitSlicedPopulation<T>(x.nbchr, x.nbit);
+   if (v.nbchr != x.nbchr || v.nbit != x.nbit) v = BitSlicedPopulation<T>(x.nbchr, x.nbit);
+
+   const size_t size = x.words.size();
+   for (size_t i = 0; i < size; ++i) {
+      uint64_t m = rng();
+      u.words[i] = (x.words[i] & m) | (y.words[i] & ~m);
+      v.words[i] = (y.words[i] & m) | (x.words[i] & ~m);
+   }
+}
+
+/*-------------------------------------------------------------------------------------------------*/
+
+// number of bits set in each chromosome, counted with bit-sliced adders (64 chromosomes at once)
+template <typename T>
+void BitSlicedPopulation<T>::popcount(std::vector<int>& ones) const
+{
+   ones.assign(nbchr, 0);
+
+   int nbcounter = 1;
+   while ((1 << nbcounter) <= nbit) nbcounter++;
+   std::vector<uint64_t> counter(nbcounter);
+
+   for (int b = 0; b < nbblk; ++b) {
+      std::fill(counter.begin(), counter.end(), 0);
+      for (int bit = 0; bit < nbit; ++bit) {
+         uint64_t carry = words[(size_t)bit * nbblk + b];
+         for (int k = 0; carry != 0 && k < nbcounter; ++k) {
+            uint64_t t = counter[k] & carry;
+            counter[k] ^= carry;
+            carry = t;
+         }
+      }
+      int n = std::min(64, nbchr - b * 64);
+      for (int j = 0; j < n; ++j) {
+         int count = 0;
+         for (int k = 0; k < nbcounter; ++k) count |= (int)((counter[k] >> j) & 1) << k;
+         ones[b * 64 + j] = count;
+      }
+   }
+}
+
+/*-------------------------------------------------------------------------------------------------*/
+
+// sum of weights w[bit] of bits set in each chromosome, work proportional to number of bits set
+template <typename T>
+void BitSlicedPopulation<T>::weighted(const std::vector<double>& w, std::vector<double>& sum) const
+{
+   if ((int)w.size() != nbit) {
+      throw std::invalid_argument("Error: in class galgo::BitSlicedPopulation<T>, number of weights must be equal to number of bits, please adjust.");
+   }
+   sum.assign(nbchr, 0.0);
+
+   for (int bit = 0; bit < nbit; ++bit) {
+      if (w[bit] == 0.0) continue;
+      const uint64_t* s = slice(bit);
+      for (int b = 0; b < nbblk; ++b) {
+         for (uint64_t x = s[b]; x != 0; x &= x - 1) {
+            sum[b * 64 + TrailingZeros(x)] += w[bit];
+         }
+      }
+   }
+}
+
+//=================================================================================================
+
+}
+
+#endif
@@ -0,0 +1,81 @@
+//=================================================================================================
+//                  Copyright (C) 2018 Alain Lanthier - All Rights Reserved
+//                  License: MIT License    See LICENSE.md for the full license.
+//                  Original code 2017 Olivier Mallet (MIT License)
+//=================================================================================================
+
+#ifndef BULKDECODE_HPP
+#define BULKDECODE_HPP
+
+namespace galgo {
+
+//=================================================================================================
+
+// extract n bits (1 to 64) starting at bit position pos from packed words
+inline uint64_t ExtractBits(const uint64_t* words, int pos, int n)
+{
+   const int w = pos >> 6;
+   const int off = pos & 63;
+   uint64_t x = words[w] << off;
+   if (off) x |= words[w + 1] >> (64 - off);
+   return x >> (64 - n);
+}
+
+/*-------------------------------------------------------------------------------------------------*/
+
+// decode chromosomes pop[first...last-1] into matrix x of (last - first) rows by nbparam columns
+// idx holds start bit of each parameter, bounds are taken from the chromosomes
+// real values are obtained with one fused multiply-add per parameter, they may differ from
+// Parameter<T,N>::decode() in the last bit
+template <typename T>
+void BulkDecode(const std::vector<CHR<T>>& pop, int first, int last, const std::vector<int>& idx, std::vector<T>& x)
+{
+   const int nbchr = last - first;
+   const int nbparam = (int)idx.size();
+   x.resize((size_t)std::max(nbchr, 0) * nbparam);
+   if (nbchr <= 0 || nbparam == 0) return;
+
+   const int nbbit = pop[first]->size();
+   const std::vector<T>& lowerBound = pop[first]->lowerBound();
+   const std::vector<T>& upperBound = pop[first]->upperBound();
+
+   // per parameter offset and scaling
+   std::vector<int> width(nbparam);
+   std::vector<double> lower(nbparam);
+   std::vector<double> scale(nbparam);
+   for (int k = 0; k < nbparam; ++k) {
+      width[k] = (k + 1 < nbparam ? idx[k + 1] : nbbit) - idx[k];
+      double maxval = (double)(width[k] == 64 ? ~uint64_t(0) : (uint64_t(1) << width[k]) - 1);
+      lower[k] = (double)lowerBound[k];
+      scale[k] = ((double)upperBound[k] - (double)lowerBound[k]) / maxval;
+   }
+
+   const SimdKernels& simd = Simd();
+   std::vector<uint64_t> words((nbbit + 63) / 64 + 1);
+   std::vector<double> bits(nbparam);
+   std::vector<double> row(nbparam);
+
+   for (int r = 0; r < nbchr; ++r) {
+      simd.packbits(pop[first + r]->getBits(), words.data());
+      T* y = x.data() + (size_t)r * nbparam;
+
+      if (std::is_integral<T>::value) {
+         for (int k = 0; k < nbparam; ++k) {
+            int64_t v = (int64_t)lowerBound[k] + (int64_t)ExtractBits(words.data(), idx[k], width[k]);
+            y[k] = (T)std::min<int64_t>(std::max<int64_t>(v, (int64_t)lowerBound[k]), (int64_t)upperBound[k]);
+         }
+      } else {
+         for (int k = 0; k < nbparam; ++k) {
+            bits[k] = (double)ExtractBits(words.data(), idx[k], width[k]);
+         }
+         simd.scalebits(bits.data(), scale.data(), lower.data(), row.data(), nbparam);
+         std::copy(row.begin(), row.end(), y);
+      }
+   }
+}
+
+//=================================================================================================
+
+}
+
+#endif
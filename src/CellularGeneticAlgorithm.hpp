@@ -0,0 +1,351 @@
+//=================================================================================================
+//                  Copyright (C) 2018 Alain Lanthier - All Rights Reserved
+//                  License: MIT License    See LICENSE.md for the full license.
+//                  Original code 2017 Olivier Mallet (MIT License)
+//=================================================================================================
+
+#ifndef CELLULARGENETICALGORITHM_HPP
+#define CELLULARGENETICALGORITHM_HPP
+
+namespace galgo
+{
+    /*-------------------------------------------------------------------------------------------------*/
+    // Cellular genetic algorithm: chromosomes live on a 2D torus (width x height) and only mate with
+    // their neighbours (Moore neighbourhood of given radius). Each generation the grid is updated
+    // synchronously tile by tile, an offspring replacing its cell only if it is not worse, so that the
+    // best chromosome is never lost (elitism is implicit, elitpop cannot be > 1).
+    // There is no global selection nor global sort, tiles are processed in parallel.
+    // The grid is copied into the population (result(), print(), reporter) only when it is read.
+    template <typename T>
+    class CellularGeneticAlgorithm : public GeneticAlgorithm<T>
+    {
+    public:
+        int width;          // grid width
+        int height;         // grid height
+        int radius = 1;     // neighbourhood radius (1 => 9 cells, 2 => 25 cells)
+        int tilesize = 8;   // tile side length, a tile is the unit of parallel work
+
+        // constructor
+        template <int...N> CellularGeneticAlgorithm(const ConfigInfo<T>& config, int width, int height, const Parameter<T, N>&...args);
+
+        // run cellular genetic algorithm
+        void run() override;
+
+        // return chromosome in cell (x,y)
+        const CHR<T>& cell(int x, int y) const;
+
+    protected:
+        std::vector<CHR<T>> grid;   // current grid of chromosomes
+        std::vector<CHR<T>> next;   // next grid of chromosomes
+        int best = 0;               // index of best chromosome in grid
+        std::vector<Population<T>> locals; // local mating population of each thread (cross-over, FixedValue)
+
+        // check inputs validity
+        void check() const;
+
+        // evolve all cells of a tile, return index of best chromosome of the tile
+        int evolve_tile(int tx, int ty, Population<T>& local);
+
+        // breed a new chromosome for cell (x,y) from its neighbourhood
+        CHR<T> breed(int x, int y, Population<T>& local) const;
+
+        // tournament selection among neighbourhood of cell (x,y)
+        const CHR<T>& select(int x, int y) const;
+
+        // update best chromosome reported by result()
+        void publish();
+
+        int index(int x, int y) const
+        {
+            x = (x % width + width) % width;
+            y = (y % height + height) % height;
+            return y * width + x;
+        }
+    };
+
+    /*-------------------------------------------------------------------------------------------------*/
+
+    // constructor
+    template <typename T> template <int...N>
+    CellularGeneticAlgorithm<T>::CellularGeneticAlgorithm(const ConfigInfo<T>& config, int width, int height, const Parameter<T, N>&...args)
+        : GeneticAlgorithm<T>(config), width(width), height(height)
+    {
+        this->nbbit = sum(N...);
+        this->nbparam = sizeof...(N);
+        TUP<T, N...> tp(args...);
+        this->init(tp);
+
+        // population size is given by grid size
+        this->popsize = width * height;
+        this->matsize = this->popsize;
+    }
+
+    /*-------------------------------------------------------------------------------------------------*/
+
+    // check inputs validity
+    template <typename T>
+    void CellularGeneticAlgorithm<T>::check() const
+    {
+        GeneticAlgorithm<T>::check();
+
+        if (width <= 0 || height <= 0) {
+            throw std::invalid_argument("Error: in class galgo::CellularGeneticAlgorithm<T>, grid width and height must be > 0, please adjust.");
+        }
+        if (radius < 1 || 2 * radius + 1 > std::min(width, height)) {
+            throw std::invalid_argument("Error: in class galgo::CellularGeneticAlgorithm<T>, neighbourhood radius must be >= 1 and fit inside the grid, please adjust.");
+        }
+        if (tilesize <= 0) {
+            throw std::invalid_argument("Error: in class galgo::CellularGeneticAlgorithm<T>, tile size (tilesize) cannot be <= 0, please choose an integral value > 0.");
+        }
+        if (this->Constraint != nullptr) {
+            throw std::invalid_argument("Error: in class galgo::CellularGeneticAlgorithm<T>, constraint(s) are not supported, please use galgo::GeneticAlgorithm<T>.");
+        }
+        if (this->BatchObjective != nullptr) {
+            throw std::invalid_argument("Error: in class galgo::CellularGeneticAlgorithm<T>, batch objective is not supported (cells are evaluated one by one), please set Objective instead.");
+        }
+        if (this->multiobjective) {
+            throw std::invalid_argument("Error: in class galgo::CellularGeneticAlgorithm<T>, multi-objective ranking is not supported (cells compare objective totals), please adjust.");
+        }
+        if (this->elitpop > 1) {
+            throw std::invalid_argument("Error: in class galgo::CellularGeneticAlgorithm<T>, elit population (elitpop) cannot be > 1 (a cell only keeps a not worse offspring, best chromosome is never lost), please adjust.");
+        }
+        if (this->ObjectiveBounded != nullptr) {
+            throw std::invalid_argument("Error: in class galgo::CellularGeneticAlgorithm<T>, early abort objective (ObjectiveBounded) is not supported (cells are evaluated without bound), please set Objective instead.");
+        }
+        if (this->pipeline_ratio != 0.0) {
+            throw std::invalid_argument("Error: in class galgo::CellularGeneticAlgorithm<T>, pipelining (pipeline_ratio) is not supported (cells are evaluated within their tile), please set pipeline_ratio to 0.0.");
+        }
+        if (!this->checkpoint.empty() || this->checkpointstep != 0 || this->resume) {
+            throw std::invalid_argument("Error: in class galgo::CellularGeneticAlgorithm<T>, checkpoints (checkpoint, checkpointstep, resume) are not supported, please adjust.");
+        }
+    }
+
+    /*-------------------------------------------------------------------------------------------------*/
+
+    // run cellular genetic algorithm
+    template <typename T>
+    void CellularGeneticAlgorithm<T>::run()
+    {
+        check();
+
+        // population is only used to publish the best chromosome (result(), StopCondition)
+        this->pop = Population<T>(*this);
+
+        if (this->output) {
+            std::cout << "\n Running Cellular Genetic Algorithm...\n";
+            std::cout << " -------------------------------------\n";
+        }
+
+        auto start = std::chrono::steady_clock::now();
+#ifdef GALGO_MEMORY
+        this->memory->restart();
+#endif
+
+        // creating grid
+        grid.resize(this->popsize);
+        next.resize(this->popsize);
+        this->nogen = 0;
+
+        #ifdef _OPENMP
+        #pragma omp parallel for num_threads(MAX_THREADS)
+        #endif
+        for (int i = 0; i < this->popsize; ++i) {
+            grid[i] = std::make_shared<Chromosome<T>>(*this);
+            if (i == 0 && !this->initialSet.empty()) grid[i]->initialize();
+            else grid[i]->create();
+            grid[i]->evaluate();
+        }
+        best = (int)std::distance(grid.begin(), std::max_element(grid.begin(), grid.end(), [](const CHR<T>& chr1, const CHR<T>& chr2)->bool{return chr1->fitness < chr2->fitness;}));
+        publish();
+        this->accounting();
+
+        double bestResult = grid[best]->getTotal();
+        double prevBestResult = bestResult;
+
+        if (this->output) this->print();
+        if (this->reporter != nullptr) {
+            double t = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            this->report(t, t);
+        }
+
+        int ntx = (width + tilesize - 1) / tilesize;
+        int nty = (height + tilesize - 1) / tilesize;
+        std::vector<int> tilebest(ntx * nty);
+
+        // local mating populations reused by every offspring bred by a thread
+        #ifdef _OPENMP
+        int nbthread = MAX_THREADS;
+        #else
+        int nbthread = 1;
+        #endif
+        locals.clear();
+        for (int i = 0; i < nbthread; ++i) locals.emplace_back(*this, std::vector<CHR<T>>());
+
+        for (this->nogen = 1; this->nogen <= this->nbgen; ++this->nogen)
+        {
+            auto genstart = std::chrono::steady_clock::now();
+
+            // evolving all tiles, each tile reads current grid and writes its own cells of next grid
+            #ifdef _OPENMP
+            #pragma omp parallel for schedule(dynamic) num_threads(MAX_THREADS)
+            #endif
+            for (int t = 0; t < ntx * nty; ++t) {
+                #ifdef _OPENMP
+                Population<T>& local = locals[omp_get_thread_num()];
+                #else
+                Population<T>& local = locals[0];
+                #endif
+                tilebest[t] = evolve_tile(t % ntx, t / ntx, local);
+            }
+            grid.swap(next);
+
+            // reducing best of each tile
+            best = tilebest[0];
+            for (int t = 1; t < ntx * nty; ++t) {
+                if (grid[tilebest[t]]->fitness > grid[best]->fitness) best = tilebest[t];
+            }
+
+            bestResult = grid[best]->getTotal();
+            this->accounting();
+
+            // grid is read by print(), report() and StopCondition
+            bool outputting = this->nogen % this->genstep == 0 && (this->output || this->reporter != nullptr);
+            if (outputting || this->StopCondition != nullptr) publish();
+
+            if (this->output) this->print();
+            if (this->reporter != nullptr) {
+                auto now = std::chrono::steady_clock::now();
+                this->report(std::chrono::duration<double>(now - genstart).count(), std::chrono::duration<double>(now - start).count());
+            }
+
+            if (this->tolerance != 0.0)
+            {
+                if (fabs(bestResult - prevBestResult) < fabs(this->tolerance))
+                {
+                    break;
+                }
+                prevBestResult = bestResult;
+            }
+
+            if (this->StopCondition != nullptr)
+            {
+                if (this->StopCondition(*this) == true)
+                {
+                    break;
+                }
+            }
+        }
+
+        // last grid returned by result()
+        publish();
+
+        // writing rows of history log still buffered
+        if (this->history != nullptr) this->history->flush();
+
+        // waiting for reporter to write last snapshots
+        if (this->reporter != nullptr) this->reporter->flush();
+
+        // writing trace events
+        if (this->trace != nullptr) this->trace->flush();
+    }
+
+    /*-------------------------------------------------------------------------------------------------*/
+
+    // evolve all cells of tile (tx,ty)
+    template <typename T>
+    int CellularGeneticAlgorithm<T>::evolve_tile(int tx, int ty, Population<T>& local)
+    {
+        int xend = std::min(width, (tx + 1) * tilesize);
+        int yend = std::min(height, (ty + 1) * tilesize);
+        int tbest = index(tx * tilesize, ty * tilesize);
+
+        for (int y = ty * tilesize; y < yend; ++y) {
+            for (int x = tx * tilesize; x < xend; ++x) {
+                int k = index(x, y);
+                CHR<T> child = breed(x, y, local);
+
+                // replacing cell only if offspring is not worse
+                if (child->fitness >= grid[k]->fitness) next[k] = child;
+                else next[k] = grid[k];
+
+                if (next[k]->fitness > next[tbest]->fitness) tbest = k;
+            }
+        }
+        return tbest;
+    }
+
+    /*-------------------------------------------------------------------------------------------------*/
+
+    // breed a new chromosome for cell (x,y) from its neighbourhood, local mating population of
+    // calling thread holds the 2 neighbours selected
+    template <typename T>
+    CHR<T> CellularGeneticAlgorithm<T>::breed(int x, int y, Population<T>& local) const
+    {
+        const CHR<T>& mate1 = select(x, y);
+        const CHR<T>& mate2 = select(x, y);
+        local.mating(mate1, mate2);
+
+        CHR<T> chr1;
+        if (proba(rng) < this->covrate) {
+            // crossing-over the 2 neighbours through local mating population
+            chr1 = std::make_shared<Chromosome<T>>(*this);
+            CHR<T> chr2 = std::make_shared<Chromosome<T>>(*this);
+            this->CrossOver(local, chr1, chr2);
+        } else {
+            chr1 = std::make_shared<Chromosome<T>>(*mate1);
+            transmit_sigma<T>(*mate1, *chr1);
+        }
+
+        // mutating new chromosome
+        this->Mutation(chr1);
+
+        // setting fixed parameter value(s) through local population holding the new chromosome
+        if (this->FixedValue != nullptr) {
+            local.get_newpop().assign(1, chr1);
+            this->FixedValue(local, 0);
+        }
+
+        // evaluating new chromosome
+        chr1->evaluate();
+
+        return chr1;
+    }
+
+    /*-------------------------------------------------------------------------------------------------*/
+
+    // tournament selection among neighbourhood of cell (x,y)
+    template <typename T>
+    const CHR<T>& CellularGeneticAlgorithm<T>::select(int x, int y) const
+    {
+        int side = 2 * radius + 1;
+
+        const CHR<T>* sel = &grid[index(x + uniform<int>(0, side) - radius, y + uniform<int>(0, side) - radius)];
+        for (int j = 1; j < this->tntsize; ++j) {
+            const CHR<T>& chr = grid[index(x + uniform<int>(0, side) - radius, y + uniform<int>(0, side) - radius)];
+            if (chr->fitness > (*sel)->fitness) sel = &chr;
+        }
+        return *sel;
+    }
+
+    /*-------------------------------------------------------------------------------------------------*/
+
+    // expose grid as population with best chromosome first (no sorting)
+    template <typename T>
+    void CellularGeneticAlgorithm<T>::publish()
+    {
+        std::vector<CHR<T>>& curpop = this->pop.get_curpop();
+        curpop = grid;
+        std::swap(curpop[0], curpop[best]);
+    }
+
+    /*-------------------------------------------------------------------------------------------------*/
+
+    // return chromosome in cell (x,y)
+    template <typename T>
+    inline const CHR<T>& CellularGeneticAlgorithm<T>::cell(int x, int y) const
+    {
+        return grid[index(x, y)];
+    }
+
+}
+#endif
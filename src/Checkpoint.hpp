@@ -0,0 +1,180 @@
+//=================================================================================================
+//                  Copyright (C) 2018 Alain Lanthier - All Rights Reserved
+//                  License: MIT License    See LICENSE.md for the full license.
+//                  Original code 2017 Olivier Mallet (MIT License)
+//=================================================================================================
+
+#ifndef CHECKPOINT_HPP
+#define CHECKPOINT_HPP
+
+namespace galgo {
+
+//=================================================================================================
+
+// Binary checkpoint of a GA run: values are stored as raw bytes of the machine writing them, so a
+// checkpoint is meant to be read back on the same platform by the same program (same type T).
+// Genomes are stored packed, 64 bits per word.
+
+// checkpoint format identification
+const char CHECKPOINT_MAGIC[8] = { 'G', 'A', 'L', 'G', 'O', 'C', 'K', 'P' };
+const uint32_t CHECKPOINT_VERSION = 2;
+
+/*-------------------------------------------------------------------------------------------------*/
+
+// serialization of checkpoint into a memory buffer
+class CheckpointWriter
+{
+public:
+   // append raw bytes of trivially copyable value
+   template <typename U>
+   void put(const U& x)
+   {
+      const char* p = reinterpret_cast<const char*>(&x);
+      data.insert(data.end(), p, p + sizeof(U));
+   }
+
+   // append size and elements of vector
+   template <typename U>
+   void put(const std::vector<U>& x)
+   {
+      put<uint64_t>(x.size());
+      const char* p = reinterpret_cast<const char*>(x.data());
+      data.insert(data.end(), p, p + x.size() * sizeof(U));
+   }
+
+   // append size and characters of string
+   void put(const std::string& s)
+   {
+      put<uint64_t>(s.size());
+      data.insert(data.end(), s.begin(), s.end());
+   }
+
+   // append string of '0' and '1' packed into 64 bits words
+   void putBits(const std::string& bits)
+   {
+      put<uint64_t>(bits.size());
+      for (size_t i = 0; i < bits.size(); i += 64) {
+         uint64_t w = 0;
+         for (size_t j = i; j < std::min(i + 64, bits.size()); ++j) {
+            w |= (uint64_t)(bits[j] == '1') << (j - i);
+         }
+         put(w);
+      }
+   }
+
+   std::vector<char>& buffer() { return data; }
+
+private:
+   std::vector<char> data;
+};
+
+/*-------------------------------------------------------------------------------------------------*/
+
+// deserialization of checkpoint from a memory buffer
+class CheckpointReader
+{
+public:
+   CheckpointReader(std::vector<char> buffer) : data(std::move(buffer)) {}
+
+   template <typename U>
+   void get(U& x)
+   {
+      need(sizeof(U));
+      std::memcpy(&x, data.data() + pos, sizeof(U));
+      pos += sizeof(U);
+   }
+
+   template <typename U>
+   void get(std::vector<U>& x)
+   {
+      uint64_t n;
+      get(n);
+      need(n * sizeof(U));
+      x.resize(n);
+      // empty vector may have no storage (memcpy needs a valid pointer)
+      if (n == 0) return;
+      std::memcpy(x.data(), data.data() + pos, n * sizeof(U));
+      pos += n * sizeof(U);
+   }
+
+   void get(std::string& s)
+   {
+      uint64_t n;
+      get(n);
+      need(n);
+      s.assign(data.data() + pos, n);
+      pos += n;
+   }
+
+   void getBits(std::string& bits)
+   {
+      uint64_t n;
+      get(n);
+      bits.resize(n);
+      for (size_t i = 0; i < n; i += 64) {
+         uint64_t w;
+         get(w);
+         for (size_t j = i; j < std::min<size_t>(i + 64, n); ++j) {
+            bits[j] = (w >> (j - i)) & 1 ? '1' : '0';
+         }
+      }
+   }
+
+private:
+   std::vector<char> data;
+   size_t pos = 0;
+
+   void need(uint64_t n) const
+   {
+      if (n > data.size() - pos) {
+         throw std::invalid_argument("Error: in class galgo::CheckpointReader, checkpoint file is truncated or corrupted, please use another checkpoint.");
+      }
+   }
+};
+
+/*-------------------------------------------------------------------------------------------------*/
+
+// replace file path by file tmp (std::rename fails on Windows when path exists, POSIX rename
+// replaces it atomically)
+inline bool ReplaceFile(const std::string& tmp, const std::string& path)
+{
+#ifdef _WIN32
+   return MoveFileExA(tmp.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+   return std::rename(tmp.c_str(), path.c_str()) == 0;
+#endif
+}
+
+// write buffer to file, through a temporary file renamed at the end so that an interrupted
+// write never replaces previous checkpoint
+inline void WriteCheckpoint(const std::string& path, const std::vector<char>& data)
+{
+   const std::string tmp = path + ".tmp";
+   FILE* f = std::fopen(tmp.c_str(), "wb");
+   bool ok = f != nullptr && std::fwrite(data.data(), 1, data.size(), f) == data.size();
+   if (f != nullptr) ok = (std::fclose(f) == 0) && ok;
+   if (!ok || !ReplaceFile(tmp, path)) {
+      throw std::invalid_argument("Error: in galgo::WriteCheckpoint(), cannot write checkpoint file " + path + ", please check path.");
+   }
+}
+
+// read whole file, return false if it does not exist
+inline bool ReadCheckpoint(const std::string& path, std::vector<char>& data)
+{
+   FILE* f = std::fopen(path.c_str(), "rb");
+   if (f == nullptr) return false;
+   data.clear();
+   char block[65536];
+   size_t n;
+   while ((n = std::fread(block, 1, sizeof(block), f)) > 0) {
+      data.insert(data.end(), block, block + n);
+   }
+   std::fclose(f);
+   return true;
+}
+
+//=================================================================================================
+
+}
+
+#endif
@@ -19,6 +19,8 @@ namespace galgo {
         Chromosome(const GeneticAlgorithm<T>& ga);
         // copy constructor
         Chromosome(const Chromosome<T>& rhs);
+        // destructor
+        ~Chromosome();
 
         // create new chromosome 
         void create();
@@ -28,6 +30,17 @@ namespace galgo {
         void initialize();
         // evaluate chromosome 
         void evaluate();
+        // evaluate chromosome with given objective (function pointer or functor)
+        template <typename O> void evaluate(const O& objective);
+        // evaluate chromosome with allocation free objective
+        void evaluate(const SpanObjective<T>& objective);
+        // evaluate chromosome with early abort objective
+        void evaluate(const BoundedObjective<T>& objective);
+        // set parameter value(s) and objective function result(s) computed by a batch objective
+        void evaluate(const T* values, const std::vector<double>& res);
+        // constraint-first mode: set parameter value(s) and check constraint(s), return true if
+        // chromosome is infeasible and needs no objective evaluation
+        bool screen(const T* values);
         // reset chromosome
         void reset();
         // set or replace kth gene by a new one
@@ -50,14 +63,21 @@ namespace galgo {
         // get parameter value(s) from chromosome
         const std::vector<T>& getParam() const;
 
+        // get string of bits representing chromosome
+        const std::string& getBits() const;
+        // replace string of bits representing chromosome
+        void setBits(const std::string& bits);
+
         // get objective function result
         const std::vector<double>& getResult() const;
 
         // get the total sum of all objective function(s) result
         double getTotal() const;
 
-        // get constraint value(s)
-        const std::vector<double> getConstraint() const;
+        // get constraint value(s), computed when chromosome was evaluated
+        const std::vector<double>& getConstraint() const;
+        // return false if any constraint is violated (value >= 0)
+        bool feasible() const;
 
         // return chromosome size in number of bits
         int size() const;
@@ -87,6 +107,13 @@ namespace galgo {
         double get_sigma(int k) const;
         long get_sigma_iteration(int k) const;
 
+        // write or read back whole chromosome state (checkpoint)
+        void save(CheckpointWriter& out) const;
+        void load(CheckpointReader& in);
+        // write or read back genome only (chromosome still being evaluated, checkpoint)
+        void saveGenome(CheckpointWriter& out) const;
+        void loadGenome(CheckpointReader& in);
+
         void sigma_update(int k, double new_sigma)
         {
             _sigma_iteration[k]++;
@@ -94,8 +121,24 @@ namespace galgo {
         }
 
     private:
+        // decode all parameter(s) from chromosome string
+        void decode();
+        // decode kth parameter
+        T decode(int k) const;
+        // encode known value of kth parameter
+        std::string encode(int k, T x) const;
+        // compute constraint value(s) of current parameter(s)
+        void constrain();
+        // constraint-first mode: check constraint(s) of current parameter(s) before objective
+        bool screen();
+        // append evaluated chromosome to history log (if any)
+        void record() const;
+        // account memory held by chromosome containers (see MemoryAccount)
+        void account();
+
         std::vector<T> param;                     // estimated parameter(s)
         std::vector<double> result;               // chromosome objective function(s) result
+        std::vector<double> constraint;           // chromosome constraint value(s) (empty if no constraint)
         std::string chr;                          // string of bits representing chromosome
         const GeneticAlgorithm<T>* ptr = nullptr; // pointer to genetic algorithm
 
@@ -104,11 +147,18 @@ namespace galgo {
 
     public:
         double fitness;                         // chromosome fitness, objective function(s) result that can be modified (adapted to constraint(s), set to positive values, etc...)
+        int rank = 0;                           // Pareto rank (multi-objective mode, 0 = non-dominated)
+        double crowding = 0.0;                  // crowding distance inside its Pareto front (multi-objective mode)
+        bool pruned = false;                    // evaluation abandoned by early abort objective (result is partial)
 
     private:
         double total;                           // total sum of objective function(s) result
         int chrsize;                            // chromosome size (in number of bits)
         int numgen;                             // numero of generation
+#ifdef GALGO_MEMORY
+        MemoryAccount* memory;                  // memory account of genetic algorithm (not owned)
+        int64_t accounted[4] = {};              // bytes accounted for genome, param, sigma and result
+#endif
     };
 
     /*-------------------------------------------------------------------------------------------------*/
@@ -124,6 +174,12 @@ namespace galgo {
         ptr = &ga;
         chrsize = ga.nbbit;
         numgen = ga.nogen;
+
+#ifdef GALGO_MEMORY
+        memory = ga.memory.get();
+        memory->add(MemoryComponent::Chromosome, (int64_t)sizeof(Chromosome<T>) + MEMORY_CONTROL_BLOCK);
+        account();
+#endif
     }
 
     /*-------------------------------------------------------------------------------------------------*/
@@ -137,14 +193,38 @@ namespace galgo {
         _sigma_iteration = rhs._sigma_iteration;
 
         result = rhs.result;
+        constraint = rhs.constraint;
         chr = rhs.chr;
         ptr = rhs.ptr;
 
         // re-initializing fitness to its original value
         fitness = rhs.total;
+        rank = rhs.rank;
+        crowding = rhs.crowding;
+        pruned = rhs.pruned;
         total = rhs.total;
         chrsize = rhs.chrsize;
         numgen = rhs.numgen;
+
+#ifdef GALGO_MEMORY
+        memory = rhs.memory;
+        memory->add(MemoryComponent::Chromosome, (int64_t)sizeof(Chromosome<T>) + MEMORY_CONTROL_BLOCK);
+        account();
+#endif
+    }
+
+    /*-------------------------------------------------------------------------------------------------*/
+
+    // destructor, giving back accounted memory
+    template <typename T>
+    Chromosome<T>::~Chromosome()
+    {
+#ifdef GALGO_MEMORY
+        memory->add(MemoryComponent::Chromosome, -((int64_t)sizeof(Chromosome<T>) + MEMORY_CONTROL_BLOCK));
+        for (int k = 0; k < 4; ++k) {
+            if (accounted[k] != 0) memory->add(static_cast<MemoryComponent>(k + 2), -accounted[k]);
+        }
+#endif
     }
 
     /*-------------------------------------------------------------------------------------------------*/
@@ -155,17 +235,14 @@ namespace galgo {
     {
         chr.clear();
 
-        int i(0);
-        for (const auto& x : ptr->param)
+        for (int i = 0; i < ptr->nbparam; ++i)
         {
             // encoding parameter random value
-            std::string str = x->encode();
+            std::string str = ptr->parameter(i)->encode();
             chr.append(str);
 
             _sigma[i] = 0.0;
             _sigma_iteration[i] = 0;
-
-            i++;
         }
     }
 
@@ -174,24 +251,20 @@ namespace galgo {
     {
         chr.clear();
 
-        int i(0);
-        for (const auto& x : ptr->param)
+        for (int i = 0; i < ptr->nbparam; ++i)
         {
             // encoding parameter random value
-            std::string str = x->encode();
+            std::string str = ptr->parameter(i)->encode();
             chr.append(str);
 
             _sigma[i] = 0.0;
             _sigma_iteration[i] = 0;
-            i++;
         }
 
-        i = 0;
-        for (const auto& x : ptr->param)
+        for (int i = 0; i < ptr->nbparam; ++i)
         {
             if (index < _init_values.size())
                 initGene(i, _init_values[index++]);
-            i++;
         }
     }
 
@@ -203,11 +276,10 @@ namespace galgo {
     {
         chr.clear();
 
-        int i(0);
-        for (const auto& x : ptr->param)
+        for (int i = 0; i < ptr->nbparam; ++i)
         {
             // encoding parameter initial value
-            std::string str = x->encode(ptr->initialSet[i++]);
+            std::string str = encode(i, ptr->initialSet[i]);
             chr.append(str);
 
             //_sigma[i] = 0.0;
@@ -221,22 +293,164 @@ namespace galgo {
     template <typename T>
     inline void Chromosome<T>::evaluate()
     {
-        int i(0);
-        for (const auto& x : ptr->param)
-        {
-            // decoding chromosome: converting chromosome string into a real value
-            param[i] = x->decode(chr.substr(ptr->idx[i], x->size()));
-            i++;
+        if (ptr->ObjectiveSpan != nullptr) {
+            evaluate(SpanObjective<T>{ ptr->ObjectiveSpan, ptr->ObjectiveContext, ptr->nbobjective });
+        } else if (ptr->ObjectiveBounded != nullptr) {
+            // no bound outside of a generation
+            const double lowest = std::numeric_limits<double>::lowest();
+            evaluate(BoundedObjective<T>{ ptr->ObjectiveBounded, lowest, lowest });
+        } else {
+            evaluate(ptr->Objective);
         }
+    }
+
+    template <typename T> template <typename O>
+    inline void Chromosome<T>::evaluate(const O& objective)
+    {
+        // decoding chromosome: converting chromosome string into real values
+        decode();
+
+        // infeasible chromosome in constraint-first mode, no objective needed
+        if (screen()) return;
 
         // computing objective result(s) 
-        result = ptr->Objective(param);
+        result = objective(param);
+        constrain();
 
         // computing sum of all results (in case there is not only one objective functions)
         total = std::accumulate(result.begin(), result.end(), 0.0);
 
         // initializing fitness to this total
         fitness = total;
+        account();
+        record();
+    }
+
+    // evaluate chromosome with allocation free objective: results are written in place and
+    // scratch memory of calling thread is recycled, nothing is allocated once result is sized
+    template <typename T>
+    inline void Chromosome<T>::evaluate(const SpanObjective<T>& objective)
+    {
+        decode();
+        if (screen()) return;
+
+        result.resize(objective.nbobjective);
+        ScratchArena& scratch = ThreadScratch();
+        scratch.reset();
+        objective.function(Span<const T>(param.data(), param.size()), Span<double>(result.data(), result.size()), objective.context, scratch);
+        constrain();
+
+        total = std::accumulate(result.begin(), result.end(), 0.0);
+        fitness = total;
+        account();
+        record();
+    }
+
+    /*-------------------------------------------------------------------------------------------------*/
+
+    // evaluate chromosome with early abort objective: a pruned chromosome gets a pessimistic total,
+    // at most the worst total of current population, so that it never outranks a complete evaluation
+    template <typename T>
+    inline void Chromosome<T>::evaluate(const BoundedObjective<T>& objective)
+    {
+        decode();
+        if (screen()) return;
+
+        pruned = false;
+        result = objective.function(param, objective.bound, pruned);
+        constrain();
+
+        total = std::accumulate(result.begin(), result.end(), 0.0);
+        if (pruned) total = std::min(total, objective.floor);
+        fitness = total;
+        account();
+        record();
+    }
+
+    /*-------------------------------------------------------------------------------------------------*/
+
+    // compute constraint value(s) once per evaluation, so that adaptation, ranking and archiving
+    // passes of later generations reuse them
+    template <typename T>
+    inline void Chromosome<T>::constrain()
+    {
+        if (ptr->Constraint != nullptr && !ptr->constraintfirst) {
+            constraint = ptr->Constraint(param);
+        }
+    }
+
+    /*-------------------------------------------------------------------------------------------------*/
+
+    // account capacity of containers, only changes are added to MemoryAccount (nothing without GALGO_MEMORY)
+    template <typename T>
+    void Chromosome<T>::account()
+    {
+#ifdef GALGO_MEMORY
+        const int64_t bytes[4] = {
+            (int64_t)chr.capacity(),
+            (int64_t)(param.capacity() * sizeof(T)),
+            (int64_t)(_sigma.capacity() * sizeof(double) + _sigma_iteration.capacity() * sizeof(long)),
+            (int64_t)((result.capacity() + constraint.capacity()) * sizeof(double)) };
+        for (int k = 0; k < 4; ++k) {
+            if (bytes[k] == accounted[k]) continue;
+            memory->add(static_cast<MemoryComponent>(k + 2), bytes[k] - accounted[k]);
+            accounted[k] = bytes[k];
+        }
+#endif
+    }
+
+    /*-------------------------------------------------------------------------------------------------*/
+
+    // append evaluated chromosome to history log
+    template <typename T>
+    inline void Chromosome<T>::record() const
+    {
+        if (ptr->history != nullptr) {
+            ptr->history->record(*this);
+        }
+    }
+
+    /*-------------------------------------------------------------------------------------------------*/
+
+    // constraint-first mode: constraint value(s) are computed before objective, an infeasible
+    // chromosome gets no objective result and lowest total, its fitness being set by adaptation
+    template <typename T>
+    inline bool Chromosome<T>::screen()
+    {
+        if (!ptr->constraintfirst || ptr->Constraint == nullptr) return false;
+
+        constraint = ptr->Constraint(param);
+        if (feasible()) return false;
+
+        result.clear();
+        total = std::numeric_limits<double>::lowest();
+        fitness = total;
+        account();
+        record();
+        return true;
+    }
+
+    template <typename T>
+    inline bool Chromosome<T>::screen(const T* values)
+    {
+        std::copy(values, values + param.size(), param.begin());
+        return screen();
+    }
+
+    /*-------------------------------------------------------------------------------------------------*/
+
+    // set parameter value(s) and objective function result(s) computed by a batch objective
+    template <typename T>
+    inline void Chromosome<T>::evaluate(const T* values, const std::vector<double>& res)
+    {
+        std::copy(values, values + param.size(), param.begin());
+
+        result = res;
+        constrain();
+        total = std::accumulate(result.begin(), result.end(), 0.0);
+        fitness = total;
+        account();
+        record();
     }
 
     /*-------------------------------------------------------------------------------------------------*/
@@ -247,6 +461,8 @@ namespace galgo {
     {
         chr.clear();
         result = 0.0;
+        constraint.clear();
+        pruned = false;
         total = 0.0;
         fitness = 0.0;
     }
@@ -264,7 +480,7 @@ namespace galgo {
 #endif
 
         // generating a new gene
-        std::string s = ptr->param[k]->encode();
+        std::string s = ptr->parameter(k)->encode();
 
         // adding or replacing gene in chromosome
         chr.replace(ptr->idx[k], s.size(), s, 0, s.size());
@@ -283,7 +499,7 @@ namespace galgo {
 #endif
 
         // encoding gene
-        std::string s = ptr->param[k]->encode(x);
+        std::string s = encode(k, x);
 
         // adding or replacing gene in chromosome
         chr.replace(ptr->idx[k], s.size(), s, 0, s.size());
@@ -400,6 +616,29 @@ namespace galgo {
 
     /*-------------------------------------------------------------------------------------------------*/
 
+    // get string of bits representing chromosome
+    template <typename T>
+    inline const std::string& Chromosome<T>::getBits() const
+    {
+        return chr;
+    }
+
+    /*-------------------------------------------------------------------------------------------------*/
+
+    // replace string of bits representing chromosome
+    template <typename T>
+    inline void Chromosome<T>::setBits(const std::string& bits)
+    {
+#ifndef NDEBUG
+        if ((int)bits.size() != chrsize) {
+            throw std::out_of_range("Error: in galgo::Chromosome<T>::setBits(const std::string&), string size does not match chromosome size.");
+        }
+#endif
+        chr = bits;
+    }
+
+    /*-------------------------------------------------------------------------------------------------*/
+
     // get objective function result
     template <typename T>
     inline const std::vector<double>& Chromosome<T>::getResult() const
@@ -420,9 +659,82 @@ namespace galgo {
 
     // get constraint value(s) for this chromosome
     template <typename T>
-    inline const std::vector<double> Chromosome<T>::getConstraint() const
+    inline const std::vector<double>& Chromosome<T>::getConstraint() const
+    {
+        return constraint;
+    }
+
+    // write whole chromosome state, parameters are stored as decoded (a batch decoding may differ
+    // from decode() in the last bit)
+    template <typename T>
+    void Chromosome<T>::save(CheckpointWriter& out) const
+    {
+        out.putBits(chr);
+        out.put(param);
+        out.put(result);
+        out.put(constraint);
+        out.put(_sigma);
+        out.put(_sigma_iteration);
+        out.put(fitness);
+        out.put(rank);
+        out.put(crowding);
+        out.put(pruned);
+        out.put(total);
+        out.put(chrsize);
+        out.put(numgen);
+    }
+
+    // read back chromosome state written by save()
+    template <typename T>
+    void Chromosome<T>::load(CheckpointReader& in)
+    {
+        in.getBits(chr);
+        in.get(param);
+        in.get(result);
+        in.get(constraint);
+        in.get(_sigma);
+        in.get(_sigma_iteration);
+        in.get(fitness);
+        in.get(rank);
+        in.get(crowding);
+        in.get(pruned);
+        in.get(total);
+        in.get(chrsize);
+        in.get(numgen);
+        account();
+    }
+
+    // write genome and mutation state only: members evaluate() never writes, so that a chromosome
+    // being evaluated by another thread can be saved
+    template <typename T>
+    void Chromosome<T>::saveGenome(CheckpointWriter& out) const
+    {
+        out.putBits(chr);
+        out.put(_sigma);
+        out.put(_sigma_iteration);
+        out.put(chrsize);
+        out.put(numgen);
+    }
+
+    // read back genome written by saveGenome(), chromosome must then be evaluated
+    template <typename T>
+    void Chromosome<T>::loadGenome(CheckpointReader& in)
+    {
+        in.getBits(chr);
+        in.get(_sigma);
+        in.get(_sigma_iteration);
+        in.get(chrsize);
+        in.get(numgen);
+        account();
+    }
+
+    /*-------------------------------------------------------------------------------------------------*/
+
+    // return false if any constraint is violated
+    template <typename T>
+    inline bool Chromosome<T>::feasible() const
     {
-        return ptr->Constraint(param);
+        return std::none_of(constraint.cbegin(), constraint.cend(), [](double x)->bool{return x >= 0.0;});
     }
 
     /*-------------------------------------------------------------------------------------------------*/
@@ -508,8 +820,86 @@ namespace galgo {
         }
 #endif
 
-        auto& x = ptr->param[k];
-        return x->decode(chr.substr(ptr->idx[k], x->size()));
+        return decode(k);
+    }
+
+    /*-------------------------------------------------------------------------------------------------*/
+
+    // decode all parameter(s) from chromosome string
+    template <typename T>
+    inline void Chromosome<T>::decode()
+    {
+        if (ptr->uniformbit == 0) {
+            for (int i = 0; i < ptr->nbparam; ++i) {
+                param[i] = decode(i);
+            }
+            return;
+        }
+
+        // uniform parameters: one loop over bounds arrays, no virtual call nor substring
+        const int n = ptr->uniformbit;
+        const int nb = ptr->nbparam;
+        const T* lb = ptr->lowerBound.data();
+        const T* ub = ptr->upperBound.data();
+        T* p = param.data();
+
+        if (std::is_integral<T>::value) {
+            for (int i = 0; i < nb; ++i) {
+                int64_t r = (int64_t)lb[i] + (int64_t)GetValue(chr, i * n, n);
+                p[i] = (T)std::min<int64_t>(std::max<int64_t>(r, (int64_t)lb[i]), (int64_t)ub[i]);
+            }
+        } else {
+            const double maxval = (double)(n == 64 ? ~uint64_t(0) : (uint64_t(1) << n) - 1);
+            for (int i = 0; i < nb; ++i) {
+                p[i] = (T)(lb[i] + (GetValue(chr, i * n, n) / maxval) * (ub[i] - lb[i]));
+            }
+        }
+    }
+
+    /*-------------------------------------------------------------------------------------------------*/
+
+    // decode kth parameter
+    template <typename T>
+    inline T Chromosome<T>::decode(int k) const
+    {
+        if (ptr->uniformbit == 0) {
+            const auto& x = ptr->param[k];
+            return x->decode(chr.substr(ptr->idx[k], x->size()));
+        }
+
+        const int n = ptr->uniformbit;
+        const T lb = ptr->lowerBound[k];
+        const T ub = ptr->upperBound[k];
+        if (std::is_integral<T>::value) {
+            int64_t r = (int64_t)lb + (int64_t)GetValue(chr, k * n, n);
+            return (T)std::min<int64_t>(std::max<int64_t>(r, (int64_t)lb), (int64_t)ub);
+        }
+        const double maxval = (double)(n == 64 ? ~uint64_t(0) : (uint64_t(1) << n) - 1);
+        return (T)(lb + (GetValue(chr, k * n, n) / maxval) * (ub - lb));
+    }
+
+    /*-------------------------------------------------------------------------------------------------*/
+
+    // encode known value of kth parameter
+    template <typename T>
+    inline std::string Chromosome<T>::encode(int k, T x) const
+    {
+        if (ptr->uniformbit == 0) {
+            return ptr->param[k]->encode(x);
+        }
+
+        const int n = ptr->uniformbit;
+        const T lb = ptr->lowerBound[k];
+        const T ub = ptr->upperBound[k];
+        uint64_t value;
+        if (std::is_integral<T>::value) {
+            value = (uint64_t)(x - lb);
+        } else {
+            const double maxval = (double)(n == 64 ? ~uint64_t(0) : (uint64_t(1) << n) - 1);
+            value = (uint64_t)(maxval * (x - lb) / (ub - lb));
+        }
+        std::string str = GetBinary(value);
+        return str.substr(str.size() - n, n);
     }
 
 
@@ -51,6 +51,10 @@ namespace galgo
             SP = 1.5;
             tolerance = 0.0;
             recombination_ratio = 0.50;
+            pipeline_ratio = 0.0;
+            constraintfirst = false;
+            checkpointstep = 0;
+            resume = false;
 
             elitpop = 1;
             tntsize = 10;
@@ -58,6 +62,12 @@ namespace galgo
             precision = 10;
 
             Objective = nullptr;
+            BatchObjective = nullptr;
+            ObjectiveSpan = nullptr;
+            ObjectiveContext = nullptr;
+            nbobjective = 1;
+            ObjectiveBounded = nullptr;
+            prunerank = 0;
             Selection = RWS;
             CrossOver = P1XO;
             //Mutation = SPM; // derived from by mutinfo._type
@@ -69,6 +79,12 @@ namespace galgo
             nbgen = 10;
             popsize = 10;
             output = false;
+            multiobjective = false;
+            archive = nullptr;
+            history = nullptr;
+            reporter = nullptr;
+            trace = nullptr;
+            memorycap = 0;
         }
 
         MutationInfo<ParamTYPE> mutinfo;
@@ -78,6 +94,9 @@ namespace galgo
         double SP;
         double tolerance;
         double recombination_ratio;
+        double pipeline_ratio;  // fraction of offspring whose evaluation is deferred to next generation, as OpenMP tasks run by threads
+                                // idle at end of its recombination (0.0 = disabled); best kept near the load imbalance of one generation
+        bool constraintfirst;   // evaluate Constraint first and skip Objective of infeasible chromosomes (default adaptation is then FeasibilityRule)
 
         int elitpop;
         //int matsize; // set to popsize when ga is constructed, maybe change by ga.matsize = ... after constructor and before ga.run()
@@ -86,6 +105,15 @@ namespace galgo
         int precision;
 
         std::vector<double>(*Objective)(const std::vector<ParamTYPE>&);
+        // batch objective: x holds result.size() rows of nbparam decoded parameters, used instead of Objective when set
+        void(*BatchObjective)(const std::vector<ParamTYPE>& x, int nbparam, std::vector<std::vector<double>>& result);
+        // allocation free objective: used instead of Objective when set, called with ObjectiveContext and nbobjective result values
+        SpanObjectiveFunc<ParamTYPE> ObjectiveSpan;
+        void* ObjectiveContext;
+        int nbobjective;
+        // early abort objective: used instead of Objective when set, called with a bound below which evaluation can be abandoned
+        BoundedObjectiveFunc<ParamTYPE> ObjectiveBounded;
+        int prunerank;          // rank in current population giving abort bound (0 = worst chromosome, elitpop = last elit)
         void(*Selection)(Population<ParamTYPE>&);
         void(*CrossOver)(const Population<ParamTYPE>&, CHR<ParamTYPE>&, CHR<ParamTYPE>&);
         void(*Mutation)(CHR<ParamTYPE>&);
@@ -100,6 +128,15 @@ namespace galgo
         int nbgen;
         int popsize;
         bool output;
+        bool multiobjective;    // Pareto-based NSGA-II ranking instead of sum of objective(s) result
+        std::string checkpoint; // checkpoint file (empty = no checkpoint)
+        int checkpointstep;     // generation step for writing checkpoint asynchronously (0 = never)
+        bool resume;            // resume run from checkpoint file if it exists
+        ParetoArchive<ParamTYPE>* archive;  // external archive of non-dominated chromosomes (owned by user, optional)
+        HistoryLog<ParamTYPE>* history;     // log of every evaluated chromosome (owned by user, optional)
+        Reporter* reporter;                 // asynchronous progress reporter (owned by user, optional)
+        TraceLog* trace;                    // Chrome trace-event log (owned by user, optional)
+        size_t memorycap;                   // maximum bytes held by galgo components (0 = no cap, requires GALGO_MEMORY)
     };
 }
 #endif
@@ -33,6 +33,20 @@ uint64_t GetValue(const std::string& s)
    return value;
 }
 
+/*-------------------------------------------------------------------------------------------------*/
+
+// convert n characters of binary string starting at position start to unsigned long long integer
+// (no substring copy)
+inline uint64_t GetValue(const std::string& s, int start, int n)
+{
+   uint64_t x = 0;
+   const char* it = s.data() + start;
+   for (int i = 0; i < n; ++i) {
+      x = (x << 1) + (uint64_t)(it[i] - '0');
+   }
+   return x;
+}
+
 //=================================================================================================
 
 }
@@ -136,15 +136,17 @@ void RNK(galgo::Population<T>& x)
    int popsize = x.popsize();
    static std::vector<int> rank(popsize);
    static int ranksum;
+   static int lastgen = 0;
 
-   // this will only be run at the first generation
-   if (x.nogen() == 1) {
+   // this will only be run at the first generation (or first one after resuming from a checkpoint)
+   if (x.nogen() == 1 || x.nogen() != lastgen + 1) {
       int n = popsize + 1;
       // generating ranks from highest to lowest
       std::generate_n(rank.begin(), popsize, [&n]()->int{return --n;});
       // computing sum of ranks
       ranksum = int (.5 * popsize * (popsize + 1));
    }
+   lastgen = x.nogen();
 
    // selecting mating population
    for (int i = 0, end = x.matsize(); i < end; ++i) {
@@ -175,9 +177,10 @@ void RSP(galgo::Population<T>& x)
    int popsize = x.popsize();
    static std::vector<double> rank(popsize);
    static double ranksum;
+   static int lastgen = 0;
 
-   // this will only be run at the first generation
-   if (x.nogen() == 1) {
+   // this will only be run at the first generation (or first one after resuming from a checkpoint)
+   if (x.nogen() == 1 || x.nogen() != lastgen + 1) {
       // initializing ranksum
       ranksum = 0.0;
       // generating ranks from highest to lowest
@@ -186,6 +189,7 @@ void RSP(galgo::Population<T>& x)
          ranksum += rank[i];
       }      
    }
+   lastgen = x.nogen();
 
    // selecting mating population
    for (int i = 0, end = x.matsize(); i < end; ++i)
@@ -248,10 +252,13 @@ template <typename T>
 void TRS(galgo::Population<T>& x)
 {
    static double c;
-   // (re)initializing when running new GA
-   if (x.nogen() == 1) {  
+   static int lastgen = 0;
+   // (re)initializing when running new GA, replaying transitions when resuming from a checkpoint
+   if (x.nogen() == 1 || x.nogen() != lastgen + 1) {  
       c =  0.2;
+      for (int i = 1; i < x.nogen(); ++i) c = c + 0.1;
    }
+   lastgen = x.nogen();
    int popsize = x.popsize();
 
    // generating a random set of popsize values on [0,1)
@@ -302,6 +309,38 @@ void TRS(galgo::Population<T>& x)
 
 /*-------------------------------------------------------------------------------------------------*/
 
+// Pareto rank tournament selection (NSGA-II crowded comparison, multi-objective mode)
+template <typename T>
+void PRT(galgo::Population<T>& x)
+{
+   int popsize = x.popsize();
+   int tntsize = std::max(2, x.tntsize());
+
+   // selecting mating population
+   for (int i = 0, end = x.matsize(); i < end; ++i) 
+   {
+      // selecting randomly a first element
+      int bestIdx = galgo::uniform<int>(0, popsize);
+   
+      // starting tournament, lower rank wins then larger crowding distance
+      for (int j = 1; j < tntsize; ++j) {
+   
+         int idx = galgo::uniform<int>(0, popsize);
+         const galgo::CHR<T>& best = x(bestIdx);
+         const galgo::CHR<T>& chr = x(idx);
+
+         if (chr->rank < best->rank || (chr->rank == best->rank && chr->crowding > best->crowding)) {
+            bestIdx = idx;
+         }
+      }
+
+      // selecting element
+      x.select(bestIdx);
+   }
+}
+
+/*-------------------------------------------------------------------------------------------------*/
+
 // CROSS-OVER METHODS
 
 template <typename T>
@@ -910,6 +949,36 @@ void DAC(galgo::Population<T>& x)
    }
 } 
 
+/*-------------------------------------------------------------------------------------------------*/
+
+// adapt population with feasibility rules: any feasible chromosome is better than any infeasible one,
+// feasible ones are compared on objective and infeasible ones on total constraint violation
+// (does not need objective result of infeasible chromosomes, see ConfigInfo::constraintfirst)
+template <typename T>
+void FeasibilityRule(galgo::Population<T>& x)
+{
+   // getting worst objective function total result of feasible chromosomes
+   double worstTotal = 0.0;
+   bool found = false;
+   for (auto it = x.begin(), end = x.end(); it != end; ++it) {
+      if ((*it)->feasible()) {
+         worstTotal = found ? std::min(worstTotal, (*it)->getTotal()) : (*it)->getTotal();
+         found = true;
+      }
+   }
+
+   for (auto it = x.begin(), end = x.end(); it != end; ++it) 
+   {
+      if ((*it)->feasible()) continue;
+
+      // total violation, infeasible chromosomes strictly ranked below worst feasible one
+      const std::vector<double>& cst = (*it)->getConstraint();
+      double violation = 0.0;
+      for (double c : cst) violation += std::max(0.0, c);
+      (*it)->fitness = std::nextafter(worstTotal - violation, -std::numeric_limits<double>::infinity());
+   }
+}
+
 //================================================================================================= 
 
 #endif
@@ -0,0 +1,403 @@
+//=================================================================================================
+//                  Copyright (C) 2018 Alain Lanthier - All Rights Reserved
+//                  License: MIT License    See LICENSE.md for the full license.
+//                  Original code 2017 Olivier Mallet (MIT License)
+//=================================================================================================
+
+#ifndef FIXEDGENETICALGORITHM_HPP
+#define FIXEDGENETICALGORITHM_HPP
+
+namespace galgo
+{
+    /*-------------------------------------------------------------------------------------------------*/
+    // Genetic algorithm for a number of parameters and bit widths known at compile time.
+    // Parameters are kept in a std::tuple<Parameter<T,N>...>, each chromosome stores one unsigned
+    // integer per gene and its decoded parameters in std::array, encoding/decoding is unrolled at
+    // compile time (no virtual call, no per chromosome heap allocation).
+    // Chromosomes are evolved with tournament selection, one-point cross-over and single point
+    // mutation (the binary operators of Evolution.hpp: TNT, P1XO, SPM) plus elitism.
+    // Single objective only: other operators, constraints, objective variants, multi-objective
+    // ranking, pipelining, checkpoints and observers (archive, history, reporter, trace) of
+    // ConfigInfo are not supported and rejected by run().
+
+    // number of bits of Ith parameter of pack N
+    template <int I, int...N>
+    struct NthBit;
+
+    template <int I, int N0, int...N>
+    struct NthBit<I, N0, N...> { enum : int { value = NthBit<I - 1, N...>::value }; };
+
+    template <int N0, int...N>
+    struct NthBit<0, N0, N...> { enum : int { value = N0 }; };
+
+    /*-------------------------------------------------------------------------------------------------*/
+
+    template <typename T, int...N>
+    struct FixedChromosome
+    {
+        static constexpr int nbparam = sizeof...(N);
+
+        std::array<uint64_t, sizeof...(N)> gene;   // encoded parameter(s), one unsigned integer per parameter
+        std::array<T, sizeof...(N)> param;         // decoded parameter(s)
+        double fitness = 0.0;                      // objective function result
+    };
+
+    /*-------------------------------------------------------------------------------------------------*/
+
+    template <typename T, int...N>
+    class FixedGeneticAlgorithm
+    {
+    public:
+        static constexpr int nbparam = sizeof...(N);
+
+        using CHROMOSOME = FixedChromosome<T, N...>;
+        using PARAMS = std::array<T, sizeof...(N)>;
+
+        // objective function pointer
+        double(*Objective)(const PARAMS&) = nullptr;
+
+        double covrate = .50;   // cross-over rate
+        double mutrate = .05;   // mutation rate
+        double tolerance = 0.0; // terminal condition (inactive if equal to zero)
+
+        int elitpop = 1;        // elit population size
+        int tntsize = 10;       // tournament size
+        int genstep = 10;       // generation step for outputting results
+        int precision = 10;     // precision for outputting results
+        int nbgen;              // number of generations
+        int popsize;            // population size
+        bool output;            // control if results must be outputted
+
+        // constructor
+        FixedGeneticAlgorithm(double(*objective)(const PARAMS&), const ConfigInfo<T>& config, const Parameter<T, N>&...args);
+
+        // run genetic algorithm
+        void run();
+
+        // return best chromosome
+        const CHROMOSOME& result() const { return curpop[0]; }
+
+        // print results for each new generation
+        void print(bool force = false) const;
+
+        int get_nogen() const { return nogen; }
+
+    private:
+        std::tuple<Parameter<T, N>...> param;  // parameter(s)
+        PARAMS lowerBound;                      // parameter(s) lower bound
+        PARAMS upperBound;                      // parameter(s) upper bound
+        PARAMS initialSet;                      // initial set of parameter(s)
+        bool hasInitialSet = false;
+        std::string unsupported;                // first unsupported setting of config (empty = none)
+        int nbbit;                              // total number of bits per chromosome
+        int nogen = 0;                          // numero of generation
+
+        std::vector<CHROMOSOME> curpop;         // current population (allocated once)
+        std::vector<CHROMOSOME> newpop;         // new population (allocated once)
+
+        // unrolled per parameter operations
+        template <int I = 0> typename std::enable_if<I == sizeof...(N), void>::type init() {}
+        template <int I = 0> typename std::enable_if<I < sizeof...(N), void>::type init();
+
+        template <int I = 0> typename std::enable_if<I == sizeof...(N), void>::type create(CHROMOSOME&, bool) const {}
+        template <int I = 0> typename std::enable_if<I < sizeof...(N), void>::type create(CHROMOSOME& chr, bool initial) const;
+
+        template <int I = 0> typename std::enable_if<I == sizeof...(N), void>::type decode(CHROMOSOME&) const {}
+        template <int I = 0> typename std::enable_if<I < sizeof...(N), void>::type decode(CHROMOSOME& chr) const;
+
+        template <int I = 0> typename std::enable_if<I == sizeof...(N), void>::type mutate(CHROMOSOME&) const {}
+        template <int I = 0> typename std::enable_if<I < sizeof...(N), void>::type mutate(CHROMOSOME& chr) const;
+
+        template <int I = 0> typename std::enable_if<I == sizeof...(N), void>::type cross(CHROMOSOME&, CHROMOSOME&, int) const {}
+        template <int I = 0> typename std::enable_if<I < sizeof...(N), void>::type cross(CHROMOSOME& chr1, CHROMOSOME& chr2, int pos) const;
+
+        void evaluate(CHROMOSOME& chr) const;
+        const CHROMOSOME& select() const;
+        void sort();
+        void check() const;
+    };
+
+    /*-------------------------------------------------------------------------------------------------*/
+
+    // constructor
+    template <typename T, int...N>
+    FixedGeneticAlgorithm<T, N...>::FixedGeneticAlgorithm(double(*objective)(const PARAMS&), const ConfigInfo<T>& config, const Parameter<T, N>&...args)
+        : Objective(objective), param(args...)
+    {
+        covrate = config.covrate;
+        mutrate = config.mutrate;
+        tolerance = config.tolerance;
+        elitpop = config.elitpop;
+        tntsize = config.tntsize;
+        genstep = config.genstep;
+        precision = config.precision;
+        nbgen = config.nbgen;
+        popsize = config.popsize;
+        output = config.output;
+
+        // settings of config this genetic algorithm does not implement (ConfigInfo defaults RWS and
+        // MutationSPM stand for operators not set)
+        if (config.Selection != RWS<T> && config.Selection != TNT<T>) unsupported = "selection method other than TNT";
+        else if (config.CrossOver != P1XO<T>) unsupported = "cross-over method other than P1XO";
+        else if (config.mutinfo._type != MutationType::MutationSPM) unsupported = "mutation method other than SPM";
+        else if (config.Objective != nullptr || config.BatchObjective != nullptr || config.ObjectiveSpan != nullptr || config.ObjectiveBounded != nullptr) unsupported = "objective of ConfigInfo (objective is given to constructor)";
+        else if (config.multiobjective) unsupported = "multi-objective ranking";
+        else if (config.Constraint != nullptr || config.Adaptation != nullptr) unsupported = "constraint(s)";
+        else if (config.FixedValue != nullptr || config.StopCondition != nullptr) unsupported = "FixedValue and StopCondition";
+        else if (config.pipeline_ratio != 0.0) unsupported = "pipelining (pipeline_ratio)";
+        else if (config.checkpointstep != 0 || config.resume) unsupported = "checkpoints";
+        else if (config.archive != nullptr || config.history != nullptr || config.reporter != nullptr || config.trace != nullptr) unsupported = "archive, history log, reporter and trace";
+        else if (config.memorycap != 0) unsupported = "memory cap (memorycap)";
+
+        nbbit = sum(N...);
+        init();
+    }
+
+    /*-------------------------------------------------------------------------------------------------*/
+
+    // copying Ith parameter bounds and initial value
+    template <typename T, int...N> template <int I>
+    inline typename std::enable_if<I < sizeof...(N), void>::type FixedGeneticAlgorithm<T, N...>::init()
+    {
+        const std::vector<T>& data = std::get<I>(param).getData();
+        lowerBound[I] = data[0];
+        upperBound[I] = data[1];
+        if (data.size() > 2) {
+            initialSet[I] = data[2];
+            hasInitialSet = true;
+        } else {
+            initialSet[I] = data[0];
+        }
+        init<I + 1>();
+    }
+
+    /*-------------------------------------------------------------------------------------------------*/
+
+    // encoding random (or initial) Ith gene
+    template <typename T, int...N> template <int I>
+    inline typename std::enable_if<I < sizeof...(N), void>::type FixedGeneticAlgorithm<T, N...>::create(CHROMOSOME& chr, bool initial) const
+    {
+        constexpr int NB = NthBit<I, N...>::value;
+        if (!initial) {
+            chr.gene[I] = Randomize<NB>::generate();
+        } else if (std::is_integral<T>::value) {
+            chr.gene[I] = (uint64_t)(initialSet[I] - lowerBound[I]);
+        } else {
+            chr.gene[I] = (uint64_t)(Randomize<NB>::MAXVAL * (initialSet[I] - lowerBound[I]) / (upperBound[I] - lowerBound[I]));
+        }
+        create<I + 1>(chr, initial);
+    }
+
+    /*-------------------------------------------------------------------------------------------------*/
+
+    // decoding Ith gene (same rule as Parameter<T,N>::decode)
+    template <typename T, int...N> template <int I>
+    inline typename std::enable_if<I < sizeof...(N), void>::type FixedGeneticAlgorithm<T, N...>::decode(CHROMOSOME& chr) const
+    {
+        constexpr int NB = NthBit<I, N...>::value;
+        if (std::is_integral<T>::value) {
+            int64_t r = (int64_t)lowerBound[I] + (int64_t)chr.gene[I];
+            chr.param[I] = (T)std::min<int64_t>(std::max<int64_t>(r, (int64_t)lowerBound[I]), (int64_t)upperBound[I]);
+        } else {
+            chr.param[I] = (T)(lowerBound[I] + (chr.gene[I] / static_cast<double>(Randomize<NB>::MAXVAL)) * (upperBound[I] - lowerBound[I]));
+        }
+        decode<I + 1>(chr);
+    }
+
+    /*-------------------------------------------------------------------------------------------------*/
+
+    // single point mutation of Ith gene bits
+    template <typename T, int...N> template <int I>
+    inline typename std::enable_if<I < sizeof...(N), void>::type FixedGeneticAlgorithm<T, N...>::mutate(CHROMOSOME& chr) const
+    {
+        constexpr int NB = NthBit<I, N...>::value;
+        for (int b = 0; b < NB; ++b) {
+            if (proba(rng) <= mutrate) chr.gene[I] ^= (uint64_t(1) << b);
+        }
+        mutate<I + 1>(chr);
+    }
+
+    /*-------------------------------------------------------------------------------------------------*/
+
+    // one-point cross-over at bit position pos of the whole chromosome (bits ordered as in the
+    // string chromosome: genes in order, most significant bit first), chr1/chr2 hold the parents
+    template <typename T, int...N> template <int I>
+    inline typename std::enable_if<I < sizeof...(N), void>::type FixedGeneticAlgorithm<T, N...>::cross(CHROMOSOME& chr1, CHROMOSOME& chr2, int pos) const
+    {
+        constexpr int NB = NthBit<I, N...>::value;
+        if (pos < 0) {
+            // gene entirely after cross-over point: swapping
+            std::swap(chr1.gene[I], chr2.gene[I]);
+        } else if (pos < NB - 1) {
+            // cross-over point inside gene: swapping the NB-1-pos lowest bits
+            uint64_t mask = (uint64_t(1) << (NB - 1 - pos)) - 1;
+            uint64_t diff = (chr1.gene[I] ^ chr2.gene[I]) & mask;
+            chr1.gene[I] ^= diff;
+            chr2.gene[I] ^= diff;
+        }
+        cross<I + 1>(chr1, chr2, pos - NB);
+    }
+
+    /*-------------------------------------------------------------------------------------------------*/
+
+    // decode and evaluate chromosome
+    template <typename T, int...N>
+    inline void FixedGeneticAlgorithm<T, N...>::evaluate(CHROMOSOME& chr) const
+    {
+        decode(chr);
+        chr.fitness = Objective(chr.param);
+    }
+
+    /*-------------------------------------------------------------------------------------------------*/
+
+    // tournament selection in current population
+    template <typename T, int...N>
+    inline const typename FixedGeneticAlgorithm<T, N...>::CHROMOSOME& FixedGeneticAlgorithm<T, N...>::select() const
+    {
+        int best = uniform<int>(0, popsize);
+        for (int j = 1; j < tntsize; ++j) {
+            int idx = uniform<int>(0, popsize);
+            if (curpop[idx].fitness > curpop[best].fitness) best = idx;
+        }
+        return curpop[best];
+    }
+
+    /*-------------------------------------------------------------------------------------------------*/
+
+    // sorting chromosomes from best to worst fitness
+    template <typename T, int...N>
+    inline void FixedGeneticAlgorithm<T, N...>::sort()
+    {
+        std::sort(curpop.begin(), curpop.end(), [](const CHROMOSOME& chr1, const CHROMOSOME& chr2)->bool{return chr1.fitness > chr2.fitness;});
+    }
+
+    /*-------------------------------------------------------------------------------------------------*/
+
+    // check inputs validity
+    template <typename T, int...N>
+    void FixedGeneticAlgorithm<T, N...>::check() const
+    {
+        if (Objective == nullptr) {
+            throw std::invalid_argument("Error: in class galgo::FixedGeneticAlgorithm<T,N...>, objective function cannot be null, please adjust.");
+        }
+        if (!unsupported.empty()) {
+            throw std::invalid_argument("Error: in class galgo::FixedGeneticAlgorithm<T,N...>, " + unsupported + " not supported, please use galgo::GeneticAlgorithm<T> or adjust.");
+        }
+        if (hasInitialSet) {
+            for (int i = 0; i < nbparam; ++i) {
+                if (initialSet[i] < lowerBound[i] || initialSet[i] > upperBound[i]) {
+                    throw std::invalid_argument("Error: in class galgo::Parameter<T,N>, initial parameter value cannot be outside the parameter boundaries, please choose a value between its lower and upper bounds.");
+                }
+            }
+        }
+        if (popsize < 2) {
+            throw std::invalid_argument("Error: in class galgo::FixedGeneticAlgorithm<T,N...>, population size (popsize) cannot be < 2, please adjust.");
+        }
+        if (elitpop > popsize || elitpop < 0) {
+            throw std::invalid_argument("Error: in class galgo::FixedGeneticAlgorithm<T,N...>, elit population (elitpop) cannot outside [0,popsize], please choose an integral value within this interval.");
+        }
+        if (covrate < 0.0 || covrate > 1.0) {
+            throw std::invalid_argument("Error: in class galgo::FixedGeneticAlgorithm<T,N...>, cross-over rate (covrate) cannot outside [0.0,1.0], please choose a real value within this interval.");
+        }
+        if (genstep <= 0) {
+            throw std::invalid_argument("Error: in class galgo::FixedGeneticAlgorithm<T,N...>, generation step (genstep) cannot be <= 0, please choose an integral value > 0.");
+        }
+    }
+
+    /*-------------------------------------------------------------------------------------------------*/
+
+    // run genetic algorithm
+    template <typename T, int...N>
+    void FixedGeneticAlgorithm<T, N...>::run()
+    {
+        check();
+
+        if (output) {
+            std::cout << "\n Running Genetic Algorithm...\n";
+            std::cout << " ----------------------------\n";
+        }
+
+        // allocating populations once
+        curpop.resize(popsize);
+        newpop.resize(popsize);
+
+        // creating population
+        nogen = 0;
+        for (int i = 0; i < popsize; ++i) {
+            create(curpop[i], i == 0 && hasInitialSet);
+            evaluate(curpop[i]);
+        }
+        sort();
+
+        double bestResult = curpop[0].fitness;
+        double prevBestResult = bestResult;
+
+        if (output) print();
+
+        for (nogen = 1; nogen <= nbgen; ++nogen)
+        {
+            // elitism
+            std::copy(curpop.begin(), curpop.begin() + elitpop, newpop.begin());
+
+            // breeding rest of new population
+            for (int i = elitpop; i < popsize; i += 2)
+            {
+                CHROMOSOME& chr1 = newpop[i];
+                CHROMOSOME& chr2 = newpop[std::min(i + 1, popsize - 1)];
+                chr1 = select();
+                chr2 = select();
+
+                if (proba(rng) < covrate) {
+                    cross(chr1, chr2, uniform<int>(0, nbbit));
+                }
+
+                mutate(chr1);
+                evaluate(chr1);
+                if (i + 1 < popsize) {
+                    mutate(chr2);
+                    evaluate(chr2);
+                }
+            }
+
+            curpop.swap(newpop);
+            sort();
+
+            bestResult = curpop[0].fitness;
+
+            if (output) print();
+
+            if (tolerance != 0.0)
+            {
+                if (fabs(bestResult - prevBestResult) < fabs(tolerance))
+                {
+                    break;
+                }
+                prevBestResult = bestResult;
+            }
+        }
+    }
+
+    /*-------------------------------------------------------------------------------------------------*/
+
+    // print results for each new generation
+    template <typename T, int...N>
+    void FixedGeneticAlgorithm<T, N...>::print(bool force) const
+    {
+        if ((nogen % genstep == 0) || force)
+        {
+            const CHROMOSOME& best = curpop[0];
+            std::cout << " Generation = " << std::setw(std::to_string(nbgen).size()) << nogen << " |";
+            for (int i = 0; i < nbparam; ++i)
+            {
+                std::cout << " X";
+                if (nbparam > 1) {
+                    std::cout << std::to_string(i + 1);
+                }
+                std::cout << " = " << std::setw(2 + precision) << std::fixed << std::setprecision(precision) << best.param[i] << " |";
+            }
+            std::cout << " F(x) = " << std::setw(12) << std::fixed << std::setprecision(precision) << best.fitness << "\n";
+        }
+    }
+}
+
+#endif
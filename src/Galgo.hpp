@@ -8,25 +8,35 @@
 #define GALGO_H
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <bitset>
+#include <chrono>
 #include <functional>
+#include <future>
 #include <iomanip>
 #include <iostream>
 #include <iterator>
 #include <limits>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <numeric>
 #include <random>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <thread>
 #include <tuple>
 #include <type_traits>
 #include <vector>
 
 #include <climits>
+#include <cstdio>
+#include <cstdlib>
 #include <cmath>
 #include <cstring>
+#include <ctime>
 
 /*-------------------------------------------------------------------------------------------------*/
 
@@ -45,18 +55,29 @@ namespace galgo {
     template <typename T, int N = 16>
     class Parameter;
 
-    template <typename T>
+    // GeneticAlgorithm<T> dispatches operators through function pointers,
+    // GeneticAlgorithm<T, SelectionPolicy, CrossoverPolicy, MutationPolicy, ObjectivePolicy> resolves them at compile time
+    template <typename T, typename...Policies>
     class GeneticAlgorithm;
 
     template <typename T, int PARAM_NBIT>
     class GeneticAlgorithmN;
 
+    template <typename T>
+    class CellularGeneticAlgorithm;
+
     template <typename T>
     class Population;
 
     template <typename T>
     class Chromosome;
 
+    template <typename T>
+    class ParetoArchive;
+
+    template <typename T>
+    class HistoryLog;
+
     // convenient typedefs
     template <typename T>
     using CHR = std::shared_ptr<Chromosome<T>>;
@@ -77,16 +98,51 @@ namespace galgo {
     static const int MAX_THREADS = omp_get_max_threads();
 #endif
 
+// vector kernels built for several instruction sets and selected at runtime (see Simd.hpp)
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__)) && !defined(GALGO_NO_SIMD_DISPATCH)
+#define GALGO_SIMD_DISPATCH
+#endif
+
+#if defined(GALGO_SIMD_DISPATCH) || defined(__SSE4_2__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+// checkpoint file replacement (MoveFileEx)
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#endif
+
     /*-------------------------------------------------------------------------------------------------*/
 
 #include "Randomize.hpp"
 #include "Converter.hpp"
 #include "Parameter.hpp"
+#include "Objective.hpp"
+#include "Checkpoint.hpp"
+#include "PerThread.hpp"
+#include "Memory.hpp"
 #include "Evolution.hpp"
+#include "Pareto.hpp"
+#include "ParetoArchive.hpp"
 #include "Chromosome.hpp"
+#include "Simd.hpp"
+#include "BulkDecode.hpp"
+#include "BitSlicedPopulation.hpp"
+#include "HistoryLog.hpp"
+#include "Reporter.hpp"
+#include "PerfCounters.hpp"
+#include "Profiler.hpp"
+#include "Trace.hpp"
 #include "Population.hpp"
 #include "Config.hpp"
 #include "GeneticAlgorithm.hpp"
+#include "Policy.hpp"
+#include "CellularGeneticAlgorithm.hpp"
+#include "FixedGeneticAlgorithm.hpp"
+#include "SparseGeneticAlgorithm.hpp"
 
 //================================================================================================= 
 
@@ -11,7 +11,7 @@ namespace galgo
 {
     /*-------------------------------------------------------------------------------------------------*/
     template <typename T>
-    class GeneticAlgorithm
+    class GeneticAlgorithm<T>
     {
         template <typename K> friend class Population;
         template <typename K> friend class Chromosome;
@@ -30,6 +30,18 @@ namespace galgo
         // objective function pointer
         FuncKT<T> Objective;
 
+        // batch objective function pointer (whole population decoded at once), used instead of Objective when set
+        void(*BatchObjective)(const std::vector<T>&, int, std::vector<std::vector<double>>&) = nullptr;
+
+        // allocation free objective function pointer, used instead of Objective when set
+        SpanObjectiveFunc<T> ObjectiveSpan = nullptr;
+        void* ObjectiveContext = nullptr;   // user context passed to ObjectiveSpan
+        int nbobjective = 1;                // number of results written by ObjectiveSpan
+
+        // early abort objective function pointer, used instead of Objective when set
+        BoundedObjectiveFunc<T> ObjectiveBounded = nullptr;
+        int prunerank = 0;                  // rank in current population giving abort bound (0 = worst chromosome)
+
         // selection method initialized to roulette wheel selection                                   
         void(*Selection)(Population<T>&) = RWS;
 
@@ -52,6 +64,8 @@ namespace galgo
         double SP = 1.5;        // selective pressure for RSP selection method 
         double tolerance = 0.0; // terminal condition (inactive if equal to zero)
         double recombination_ratio = 0.50; // Real Valued crossover ratio
+        double pipeline_ratio = 0.0; // fraction of offspring evaluated by idle threads of next generation (0.0 = disabled)
+        bool constraintfirst = false; // constraint(s) evaluated first, objective skipped for infeasible chromosomes
 
         int elitpop = 1;   // elit population size
         int matsize;       // mating pool size, set to popsize by default
@@ -59,6 +73,21 @@ namespace galgo
         int genstep = 10;  // generation step for outputting results
         int precision = 10; // precision for outputting results
         bool output;   // control if results must be outputted
+        bool multiobjective = false; // Pareto-based NSGA-II ranking instead of sum of objective(s) result
+        ParetoArchive<T>* archive = nullptr; // external archive of non-dominated chromosomes, fed every generation (optional)
+        HistoryLog<T>* history = nullptr;    // log of every evaluated chromosome (optional)
+        Reporter* reporter = nullptr;        // asynchronous progress reporter, fed every genstep generations (optional)
+        TraceLog* trace = nullptr;           // Chrome trace-event log of evaluations, batches, sorts and barriers (optional)
+        size_t memorycap = 0;                // maximum bytes held by galgo components, run() fails when exceeded (0 = no cap, GALGO_MEMORY)
+#ifdef GALGO_MEMORY
+        std::shared_ptr<MemoryAccount> memory = std::make_shared<MemoryAccount>(); // bytes held by components of this genetic algorithm
+#endif
+#ifdef GALGO_PROFILE
+        mutable Profiler profiler;           // stage timings of generation loop, per thread and per generation
+#endif
+        std::string checkpoint;  // checkpoint file (empty = no checkpoint)
+        int checkpointstep = 0;  // generation step for writing checkpoint asynchronously (0 = never)
+        bool resume = false;     // resume run from checkpoint file if it exists
 
         // Prototype to set fixed value of parameters while evolving
         void(*FixedValue)(Population<T>&, int k) = nullptr;
@@ -71,13 +100,27 @@ namespace galgo
         template <int...N> GeneticAlgorithm(FuncKT<T> objective, int popsize, int nbgen, bool output, MutationInfo<T> mutinfo, const Parameter<T, N>&...args);
         template <int...N> GeneticAlgorithm(const ConfigInfo<T>& config, const Parameter<T, N>&...args);
         template <int...N> GeneticAlgorithm(const ConfigInfo<T>& config, std::vector<T> init_values, const Parameter<T, N>&...args);
+        virtual ~GeneticAlgorithm()
+        {
+#ifdef GALGO_MEMORY
+            // chromosomes give their bytes back to memory account, destroyed before it
+            pop = Population<T>();
+#endif
+        }
+
+        // run genetic algorithm (overridden by cellular and policy based genetic algorithms)
+        virtual void run();
 
-        // run genetic algorithm
-        void run();
+        // run genetic algorithm with given operators (function pointers or functors)
+        template <typename S, typename C, typename M, typename O>
+        void run(const S& selection, const C& crossover, const M& mutation, const O& objective);
 
         // return best chromosome 
         const CHR<T>& result() const;
 
+        // return non-dominated chromosomes of current population (multi-objective mode)
+        std::vector<CHR<T>> pareto() const;
+
         // print results for each new generation
         void print(bool force = false) const;
 
@@ -108,6 +151,10 @@ namespace galgo
         int nogen = 0; // numero of generation
         int nbparam;   // number of parameters to be estimated
         int popsize;   // population size
+        int uniformbit = 0; // number of bits of every parameter when all share one descriptor (GeneticAlgorithmN), 0 otherwise
+
+        // return descriptor of kth parameter (shared descriptor in uniform mode)
+        const PAR<T>& parameter(int k) const { return uniformbit > 0 ? param[0] : param[k]; }
 
         // end of recursion for initializing parameter(s) data
         template <int I = 0, int...N>
@@ -122,7 +169,20 @@ namespace galgo
 
         void init_from_config(const ConfigInfo<T>& config);
 
+        // write checkpoint of current generation asynchronously (after previous write completed)
+        void checkpointing(double bestResult, double prevBestResult);
+        // restore run state from checkpoint file, return false if it does not exist
+        bool restoring(double& bestResult, double& prevBestResult);
+        // settings a checkpoint must have been written with to be resumed (serialized)
+        std::string settings() const;
+        // send snapshot of current generation to reporter (every genstep generations)
+        void report(double seconds, double elapsed) const;
+        // update memory accounting at end of generation, fail when memory cap is exceeded
+        void accounting();
+
         std::vector<T> _init_values;
+        std::future<void> ckpjob;   // asynchronous writing of last checkpoint
+        mutable std::vector<int> reportones;    // number of chromosomes with each bit set (report)
     };
 
     template <typename T> template <int...N>
@@ -138,6 +198,9 @@ namespace galgo
     }
 
     /*-------------------------------------------------------------------------------------------------*/
+    // Genetic algorithm for a large number of parameters all encoded with PARAM_NBIT bits.
+    // A single parameter descriptor is shared by all genes, bounds are kept as arrays
+    // (lowerBound, upperBound) and chromosomes are decoded in one loop without virtual call.
     template <typename T, int PARAM_NBIT>
     class GeneticAlgorithmN : public GeneticAlgorithm<T>
     {
@@ -156,6 +219,12 @@ namespace galgo
         setMutation(config.mutinfo); // Mutation is set here
 
         Objective = config.Objective;
+        BatchObjective = config.BatchObjective;
+        ObjectiveSpan = config.ObjectiveSpan;
+        ObjectiveContext = config.ObjectiveContext;
+        nbobjective = config.nbobjective;
+        ObjectiveBounded = config.ObjectiveBounded;
+        prunerank = config.prunerank;
         Selection = config.Selection;
         CrossOver = config.CrossOver;
         Adaptation = config.Adaptation;
@@ -168,6 +237,8 @@ namespace galgo
         SP = config.SP;
         tolerance = config.tolerance;
         recombination_ratio = config.recombination_ratio;
+        pipeline_ratio = config.pipeline_ratio;
+        constraintfirst = config.constraintfirst;
 
         elitpop = config.elitpop;
         tntsize = config.tntsize;
@@ -181,6 +252,15 @@ namespace galgo
         popsize = config.popsize;
         matsize = popsize;          // matsize default to popsize
         output = config.output;
+        multiobjective = config.multiobjective;
+        archive = config.archive;
+        history = config.history;
+        reporter = config.reporter;
+        trace = config.trace;
+        memorycap = config.memorycap;
+        checkpoint = config.checkpoint;
+        checkpointstep = config.checkpointstep;
+        resume = config.resume;
 
         nogen = 0;
     }
@@ -232,15 +312,19 @@ namespace galgo
     GeneticAlgorithmN<T, PARAM_NBIT>::GeneticAlgorithmN(const ConfigInfo<T>& _config, std::vector<T>& _lowerBound, std::vector<T>& _upperBound, std::vector<T>& _initialSet)
         : GeneticAlgorithm<T>(_config)
     {
-        for (int i = 0; i < _lowerBound.size(); i++)
-        {
-            std::vector<T> w;
-            w.push_back(_lowerBound[i]); w.push_back(_upperBound[i]); w.push_back(_initialSet[i]);
-            Parameter<T, PARAM_NBIT> p(w);
-            GeneticAlgorithm<T>::param.emplace_back(new decltype(p)(p));
+        if (_lowerBound.empty() || _upperBound.size() != _lowerBound.size()) {
+            throw std::invalid_argument("Error: in class galgo::GeneticAlgorithmN<T,N>, lower and upper bounds must be non empty and of same size, please adjust.");
+        }
 
-            if (i == 0) GeneticAlgorithm<T>::idx.push_back(0);
-            else GeneticAlgorithm<T>::idx.push_back(GeneticAlgorithm<T>::idx[i - 1] + PARAM_NBIT);
+        // one descriptor shared by all parameters (only its number of bits is used)
+        Parameter<T, PARAM_NBIT> p({ _lowerBound[0], _upperBound[0] });
+        GeneticAlgorithm<T>::param.emplace_back(new decltype(p)(p));
+        GeneticAlgorithm<T>::uniformbit = PARAM_NBIT;
+
+        GeneticAlgorithm<T>::idx.resize(_lowerBound.size());
+        for (int i = 0; i < (int)_lowerBound.size(); i++)
+        {
+            GeneticAlgorithm<T>::idx[i] = i * PARAM_NBIT;
         }
         GeneticAlgorithm<T>::lowerBound = _lowerBound;
         GeneticAlgorithm<T>::upperBound = _upperBound;
@@ -283,7 +367,7 @@ namespace galgo
             idx.push_back(0);
         }
         else {
-            idx.push_back(idx[I - 1] + par.size());
+            idx.push_back(idx[I - 1] + param[I - 1]->size());
         }
         // recursing
         init<I + 1>(tp);
@@ -305,6 +389,13 @@ namespace galgo
                 throw std::invalid_argument("Error: in class galgo::GeneticAlgorithm<T>, initial set of parameters does not have the same dimension than the number of parameters, please adjust.");
             }
         }
+        if (uniformbit > 0) {
+            for (int i = 0; i < nbparam; ++i) {
+                if (lowerBound[i] >= upperBound[i]) {
+                    throw std::invalid_argument("Error: in class galgo::GeneticAlgorithmN<T,N>, lower bound cannot be equal or greater than upper bound, please amend.");
+                }
+            }
+        }
         if (SP < 1.0 || SP > 2.0) {
             throw std::invalid_argument("Error: in class galgo::GeneticAlgorithm<T>, selective pressure (SP) cannot be outside [1.0,2.0], please choose a real value within this interval.");
         }
@@ -314,9 +405,43 @@ namespace galgo
         if (covrate < 0.0 || covrate > 1.0) {
             throw std::invalid_argument("Error: in class galgo::GeneticAlgorithm<T>, cross-over rate (covrate) cannot outside [0.0,1.0], please choose a real value within this interval.");
         }
+        if (pipeline_ratio < 0.0 || pipeline_ratio >= 1.0) {
+            throw std::invalid_argument("Error: in class galgo::GeneticAlgorithm<T>, pipeline ratio (pipeline_ratio) cannot be outside [0.0,1.0), please choose a real value within this interval.");
+        }
         if (genstep <= 0) {
             throw std::invalid_argument("Error: in class galgo::GeneticAlgorithm<T>, generation step (genstep) cannot be <= 0, please choose an integral value > 0.");
         }
+        if (constraintfirst && Constraint == nullptr) {
+            throw std::invalid_argument("Error: in class galgo::GeneticAlgorithm<T>, constraint-first evaluation (constraintfirst) requires a constraint function, please set Constraint.");
+        }
+        if (checkpointstep < 0 || (checkpointstep > 0 && checkpoint.empty())) {
+            throw std::invalid_argument("Error: in class galgo::GeneticAlgorithm<T>, checkpoint step (checkpointstep) cannot be < 0 and requires a checkpoint file, please adjust.");
+        }
+        if (history != nullptr && (history->nbparam() != nbparam || history->nbbit() != nbbit)) {
+            throw std::invalid_argument("Error: in class galgo::GeneticAlgorithm<T>, history log does not have the same number of parameters and bits, please adjust.");
+        }
+        if (prunerank < 0 || prunerank > popsize) {
+            throw std::invalid_argument("Error: in class galgo::GeneticAlgorithm<T>, prune rank (prunerank) cannot be outside [0,popsize], please choose an integral value within this interval.");
+        }
+        if (ObjectiveBounded != nullptr && multiobjective) {
+            throw std::invalid_argument("Error: in class galgo::GeneticAlgorithm<T>, early abort objective (ObjectiveBounded) cannot be used with multi-objective ranking (multiobjective), please adjust.");
+        }
+        if (ObjectiveSpan != nullptr && nbobjective < 1) {
+            throw std::invalid_argument("Error: in class galgo::GeneticAlgorithm<T>, number of objectives (nbobjective) cannot be < 1, please choose an integral value >= 1.");
+        }
+#ifndef GALGO_MEMORY
+        if (memorycap > 0) {
+            throw std::invalid_argument("Error: in class galgo::GeneticAlgorithm<T>, memory cap (memorycap) requires memory accounting, please compile with GALGO_MEMORY or set memorycap to 0.");
+        }
+#endif
+        if (memorycap > 0) {
+            // current and new populations, before any objective result
+            double chromosome = sizeof(Chromosome<T>) + MEMORY_CONTROL_BLOCK + nbbit + nbparam * (sizeof(T) + sizeof(double) + sizeof(long));
+            double estimate = popsize * (2.0 * chromosome + 3.0 * sizeof(CHR<T>));
+            if (estimate > memorycap) {
+                throw std::invalid_argument("Error: in class galgo::GeneticAlgorithm<T>, estimated memory of populations (" + std::to_string((int64_t)estimate) + " bytes) exceeds memory cap (memorycap = " + std::to_string(memorycap) + " bytes), please reduce popsize or raise memorycap.");
+            }
+        }
     }
 
     /*-------------------------------------------------------------------------------------------------*/
@@ -324,13 +449,27 @@ namespace galgo
     // run genetic algorithm
     template <typename T>
     void GeneticAlgorithm<T>::run()
+    {
+        if (ObjectiveSpan != nullptr) {
+            run(Selection, CrossOver, Mutation, SpanObjective<T>{ ObjectiveSpan, ObjectiveContext, nbobjective });
+        } else if (ObjectiveBounded != nullptr) {
+            // no pruning before a population is ranked
+            run(Selection, CrossOver, Mutation, BoundedObjective<T>{ ObjectiveBounded, std::numeric_limits<double>::lowest(), std::numeric_limits<double>::max() });
+        } else {
+            run(Selection, CrossOver, Mutation, Objective);
+        }
+    }
+
+    template <typename T> template <typename S, typename C, typename M, typename O>
+    void GeneticAlgorithm<T>::run(const S& selection, const C& crossover, const M& mutation, const O& objective)
     {
         // checking inputs validity
         check();
 
         // setting adaptation method to default if needed
         if (Constraint != nullptr && Adaptation == nullptr) {
-            Adaptation = DAC;
+            if (constraintfirst) Adaptation = FeasibilityRule;
+            else Adaptation = DAC;
         }
 
         // initializing population
@@ -341,30 +480,62 @@ namespace galgo
             std::cout << " ----------------------------\n";
         }
 
-        // creating population
-        if (_init_values.size() > 0)
-            pop.creation(_init_values);
-        else
-            pop.creation();
-
-        // initializing best result and previous best result
-        double bestResult = pop(0)->getTotal();
-        double prevBestResult = bestResult;
+        auto start = std::chrono::steady_clock::now();
+#ifdef GALGO_PROFILE
+        profiler.reset();
+#endif
+#ifdef GALGO_MEMORY
+        memory->restart();
+#endif
+        double bestResult;
+        double prevBestResult;
+        int first = 1;
+
+        if (resume && restoring(bestResult, prevBestResult)) {
+            // resuming from checkpoint
+            first = nogen + 1;
+            if (output) std::cout << " Resuming from generation " << nogen << "\n";
+        } else {
+            // creating population
+            if (_init_values.size() > 0)
+                pop.creation(_init_values, objective);
+            else
+                pop.creation(objective);
+
+            // initializing best result and previous best result
+            bestResult = pop(0)->getTotal();
+            prevBestResult = bestResult;
+        }
+        accounting();
 
         // outputting results 
         if (output) print();
+        if (reporter != nullptr) {
+            double t = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            report(t, t);
+        }
 
         // starting population evolution
-        for (nogen = 1; nogen <= nbgen; ++nogen)
+        for (nogen = first; nogen <= nbgen; ++nogen)
         {
+            auto genstart = std::chrono::steady_clock::now();
+
             // evolving population
-            pop.evolution();
+            pop.evolution(selection, crossover, mutation, objective);
+#ifdef GALGO_PROFILE
+            profiler.generation();
+#endif
 
             // getting best current result
             bestResult = pop(0)->getTotal();
+            accounting();
 
             // outputting results
             if (output) print();
+            if (reporter != nullptr) {
+                auto now = std::chrono::steady_clock::now();
+                report(std::chrono::duration<double>(now - genstart).count(), std::chrono::duration<double>(now - start).count());
+            }
 
             // checking convergence
             if (tolerance != 0.0)
@@ -383,13 +554,43 @@ namespace galgo
                     break;
                 }
             }
+
+            // saving state of this generation
+            if (checkpointstep > 0 && nogen % checkpointstep == 0) {
+                checkpointing(bestResult, prevBestResult);
+            }
         }
 
+        // evaluating and merging the last offspring whose evaluation is deferred (pipelining)
+        pop.flush();
+
+        // waiting for last checkpoint to be written
+        if (ckpjob.valid()) ckpjob.get();
+
+        // writing rows of history log still buffered
+        if (history != nullptr) history->flush();
+
+        // waiting for reporter to write last snapshots
+        if (reporter != nullptr) reporter->flush();
+
+        // writing trace events
+        if (trace != nullptr) trace->flush();
+
+#ifdef GALGO_PROFILE
+        // outputting stage timings
+        if (output) profiler.summary(std::cout);
+#endif
+
+#ifdef GALGO_MEMORY
+        // outputting memory usage
+        if (output) memory->summary(std::cout);
+#endif
+
         // outputting contraint value
         if (Constraint != nullptr)
         {
             // getting best parameter(s) constraint value(s)
-            std::vector<double> cst = pop(0)->getConstraint();
+            const std::vector<double>& cst = pop(0)->getConstraint();
             if (output) {
                 std::cout << "\n Constraint(s)\n";
                 std::cout << " -------------\n";
@@ -408,6 +609,118 @@ namespace galgo
 
     /*-------------------------------------------------------------------------------------------------*/
 
+    // write checkpoint: run state is serialized into memory here (shape, generation, convergence
+    // state, random generator, population), file is written by an asynchronous task while evolution
+    // goes on, through a temporary file so that a crash while writing keeps previous checkpoint
+    template <typename T>
+    void GeneticAlgorithm<T>::checkpointing(double bestResult, double prevBestResult)
+    {
+        // writing trace events of generations saved so far
+        if (trace != nullptr) trace->flush();
+
+        CheckpointWriter out;
+        out.buffer().insert(out.buffer().end(), CHECKPOINT_MAGIC, CHECKPOINT_MAGIC + sizeof(CHECKPOINT_MAGIC));
+        out.put(CHECKPOINT_VERSION);
+        out.put<uint32_t>(sizeof(T));
+        out.put(nbparam);
+        out.put(nbbit);
+        out.put(popsize);
+        out.put(elitpop);
+        out.put(settings());
+        out.put(nogen);
+        out.put(bestResult);
+        out.put(prevBestResult);
+
+        std::ostringstream rngstate;
+        rngstate << rng;
+        out.put(rngstate.str());
+
+        pop.save(out);
+
+        // previous checkpoint must be written first (and its error, if any, reported)
+        if (ckpjob.valid()) ckpjob.get();
+
+        auto data = std::make_shared<std::vector<char>>(std::move(out.buffer()));
+        std::string path = checkpoint;
+        ckpjob = std::async(std::launch::async, [data, path]()->void { WriteCheckpoint(path, *data); });
+    }
+
+    /*-------------------------------------------------------------------------------------------------*/
+
+    // restore run state from checkpoint, evolution then goes on exactly as if run had not been
+    // interrupted (when chromosomes are bred by a single thread)
+    template <typename T>
+    bool GeneticAlgorithm<T>::restoring(double& bestResult, double& prevBestResult)
+    {
+        std::vector<char> data;
+        if (checkpoint.empty() || !ReadCheckpoint(checkpoint, data)) return false;
+
+        if (data.size() < sizeof(CHECKPOINT_MAGIC) || !std::equal(CHECKPOINT_MAGIC, CHECKPOINT_MAGIC + sizeof(CHECKPOINT_MAGIC), data.begin())) {
+            throw std::invalid_argument("Error: in class galgo::GeneticAlgorithm<T>, " + checkpoint + " is not a checkpoint file, please adjust.");
+        }
+        CheckpointReader in(std::vector<char>(data.begin() + sizeof(CHECKPOINT_MAGIC), data.end()));
+
+        uint32_t version, size;
+        int nbparam0, nbbit0, popsize0, elitpop0;
+        in.get(version);
+        in.get(size);
+        in.get(nbparam0);
+        in.get(nbbit0);
+        in.get(popsize0);
+        in.get(elitpop0);
+        if (version != CHECKPOINT_VERSION || size != sizeof(T) || nbparam0 != nbparam || nbbit0 != nbbit || popsize0 != popsize || elitpop0 != elitpop) {
+            throw std::invalid_argument("Error: in class galgo::GeneticAlgorithm<T>, checkpoint " + checkpoint + " does not match this genetic algorithm (parameters, population or version), please adjust.");
+        }
+        std::string settings0;
+        in.get(settings0);
+        if (settings0 != settings()) {
+            throw std::invalid_argument("Error: in class galgo::GeneticAlgorithm<T>, checkpoint " + checkpoint + " was written with other settings (bounds, rates, operators or objective), please adjust.");
+        }
+        in.get(nogen);
+        in.get(bestResult);
+        in.get(prevBestResult);
+
+        std::string rngstate;
+        in.get(rngstate);
+        std::istringstream(rngstate) >> rng;
+
+        pop.load(in);
+        return true;
+    }
+
+    /*-------------------------------------------------------------------------------------------------*/
+
+    // settings changing evolution of a run: parameter bounds, rates, sizes, mutation, ranking and
+    // kind of objective (operators are function pointers of this process, only their mutation type
+    // and presence are compared); number of generations, tolerance, outputs and checkpoint step may
+    // differ on resume
+    template <typename T>
+    std::string GeneticAlgorithm<T>::settings() const
+    {
+        CheckpointWriter out;
+        out.put(lowerBound);
+        out.put(upperBound);
+        out.put(covrate);
+        out.put(mutrate);
+        out.put(SP);
+        out.put(recombination_ratio);
+        out.put(pipeline_ratio);
+        out.put(matsize);
+        out.put(tntsize);
+        out.put(prunerank);
+        out.put(nbobjective);
+        out.put(constraintfirst);
+        out.put(multiobjective);
+        out.put(mutinfo._type);
+        out.put(mutinfo._sigma);
+        out.put(mutinfo._ratio_boundary);
+        out.put(mutinfo._sigma_lowest);
+        out.put<uint8_t>((BatchObjective != nullptr) | (ObjectiveSpan != nullptr) << 1 | (ObjectiveBounded != nullptr) << 2 | (Constraint != nullptr) << 3 | (FixedValue != nullptr) << 4);
+        return std::string(out.buffer().begin(), out.buffer().end());
+    }
+
+    /*-------------------------------------------------------------------------------------------------*/
+
     // return best chromosome
     template <typename T>
     inline const CHR<T>& GeneticAlgorithm<T>::result() const
@@ -417,16 +730,29 @@ namespace galgo
 
     /*-------------------------------------------------------------------------------------------------*/
 
+    // return non-dominated chromosomes of current population (population is sorted by Pareto rank)
+    template <typename T>
+    std::vector<CHR<T>> GeneticAlgorithm<T>::pareto() const
+    {
+        std::vector<CHR<T>> front;
+        for (int i = 0; i < popsize && pop(i)->rank == 0; ++i) {
+            front.push_back(pop(i));
+        }
+        return front;
+    }
+
+    /*-------------------------------------------------------------------------------------------------*/
+
     // print results for each new generation
     template <typename T>
     void GeneticAlgorithm<T>::print(bool force) const
     {
-        // getting best parameter(s) from best chromosome
-        std::vector<T> bestParam = pop(0)->getParam();
-        std::vector<double> bestResult = pop(0)->getResult();
-
         if ((nogen % genstep == 0) || force)
         {
+            // getting best parameter(s) from best chromosome
+            const std::vector<T>& bestParam = pop(0)->getParam();
+            const std::vector<double>& bestResult = pop(0)->getResult();
+
             std::cout << " Generation = " << std::setw(std::to_string(nbgen).size()) << nogen << " |";
             for (int i = 0; i < nbparam; ++i)
             {
@@ -454,6 +780,83 @@ namespace galgo
         }
     }
 
+    /*-------------------------------------------------------------------------------------------------*/
+
+    // send snapshot of current generation to reporter, statistics are computed only for reported generations
+    template <typename T>
+    void GeneticAlgorithm<T>::report(double seconds, double elapsed) const
+    {
+        if (nogen % genstep != 0) return;
+
+        // snapshot dropped when reporter is behind
+        GenerationReport* r = reporter->acquire();
+        if (r == nullptr) return;
+
+        // mean and stddev of feasible chromosomes only (chromosomes screened out by constraintfirst
+        // have lowest() total)
+        const int n = pop.popsize();
+        double sum = 0.0, sum2 = 0.0;
+        int nbfeasible = 0;
+        std::vector<int>& ones = reportones;
+        ones.assign(nbbit, 0);
+        for (int i = 0; i < n; ++i) {
+            double x = pop(i)->getTotal();
+            if (pop(i)->feasible() && x != std::numeric_limits<double>::lowest()) {
+                sum += x;
+                sum2 += x * x;
+                nbfeasible++;
+            }
+            const std::string& bits = pop(i)->getBits();
+            for (int b = 0; b < nbbit; ++b) ones[b] += bits[b] == '1';
+        }
+        // mean pairwise Hamming distance: each bit differs in ones * (n - ones) pairs
+        double pairs = 0.0;
+        for (int b = 0; b < nbbit; ++b) pairs += (double)ones[b] * (n - ones[b]);
+
+        r->nogen = nogen;
+        r->nbgen = nbgen;
+        r->best = pop(0)->getTotal();
+        r->mean = nbfeasible > 0 ? sum / nbfeasible : std::numeric_limits<double>::quiet_NaN();
+        r->stddev = nbfeasible > 0 ? std::sqrt(std::max(0.0, sum2 / nbfeasible - r->mean * r->mean)) : std::numeric_limits<double>::quiet_NaN();
+        r->feasible = nbfeasible;
+        r->diversity = n > 1 ? pairs / (0.5 * n * (n - 1)) / nbbit : 0.0;
+        r->seconds = seconds;
+        r->elapsed = elapsed;
+#ifdef GALGO_MEMORY
+        r->memory = (double)memory->total();
+        r->peakmemory = (double)memory->peakTotal();
+#endif
+        const std::vector<T>& bestParam = pop(0)->getParam();
+        r->param.assign(bestParam.cbegin(), bestParam.cend());
+        r->result = pop(0)->getResult();
+        r->timings.clear();
+#ifdef GALGO_PROFILE
+        // wall time of each stage in last generation (zero before first generation)
+        StageTimes g;
+        if (!profiler.generations().empty()) g = profiler.generations().back();
+        for (int s = 0; s < NBSTAGE; ++s) r->timings.emplace_back(STAGE_NAME[s], g[s].wall);
+#endif
+
+        reporter->publish();
+    }
+
+    /*-------------------------------------------------------------------------------------------------*/
+
+    // update memory accounting: bytes of population pointer arrays and peaks of components (GALGO_MEMORY)
+    template <typename T>
+    void GeneticAlgorithm<T>::accounting()
+    {
+#ifdef GALGO_MEMORY
+        memory->set(MemoryComponent::Population, (int64_t)pop.footprint());
+        memory->sample();
+
+        if (memorycap > 0 && memory->peakTotal() > (int64_t)memorycap) {
+            // offspring evaluated asynchronously must not outlive this run
+            pop.flush();
+            throw std::runtime_error("Error: in class galgo::GeneticAlgorithm<T>, memory held by galgo components reached " + std::to_string(memory->peakTotal()) + " bytes at generation " + std::to_string(nogen) + ", exceeding memory cap (memorycap = " + std::to_string(memorycap) + " bytes), please reduce popsize or raise memorycap.");
+        }
+#endif
+    }
 
 }
 #endif
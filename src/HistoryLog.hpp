@@ -0,0 +1,383 @@
+//=================================================================================================
+//                  Copyright (C) 2018 Alain Lanthier - All Rights Reserved
+//                  License: MIT License    See LICENSE.md for the full license.
+//                  Original code 2017 Olivier Mallet (MIT License)
+//=================================================================================================
+
+#ifndef HISTORYLOG_HPP
+#define HISTORYLOG_HPP
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define GALGO_HISTORY_MMAP
+#endif
+
+namespace galgo {
+
+//=================================================================================================
+
+// History log file layout (native byte order, every column starting on 8 bytes):
+//    file header   : "GALGOHST", version, sizeof(T), T is floating point, nbparam, nbbit, nbobjective
+//    blocks        : header (magic, number of rows n, block size in bytes) followed by columns
+//                    generation  int32[n]
+//                    fitness     double[n]
+//                    result k    double[n] for k in [0,nbobjective), NaN if chromosome has fewer results
+//                    param k     T[n] for k in [0,nbparam)
+//                    genome w    uint64[n] for w in [0,(nbbit+63)/64), bit b of genome in bit 63-(b%64) of word b/64
+// Each evaluating thread fills its own block, full blocks are appended to the file.
+
+const char HISTORY_MAGIC[8] = { 'G', 'A', 'L', 'G', 'O', 'H', 'S', 'T' };
+const uint32_t HISTORY_VERSION = 1;
+const uint32_t HISTORY_BLOCK_MAGIC = 0x4B4C4248; // "HBLK"
+
+struct HistoryHeader
+{
+   char magic[8];
+   uint32_t version;
+   uint32_t typesize;
+   uint32_t floating;
+   uint32_t nbparam;
+   uint32_t nbbit;
+   uint32_t nbobjective;
+};
+
+struct HistoryBlockHeader
+{
+   uint32_t magic;
+   uint32_t nbrow;
+   uint64_t size;
+};
+
+// size of n elements of given size rounded up to 8 bytes
+inline size_t HistoryColumnSize(size_t n, size_t size)
+{
+   return (n * size + 7) / 8 * 8;
+}
+
+/*-------------------------------------------------------------------------------------------------*/
+
+// append-only log of every evaluated chromosome (set ConfigInfo::history, owned by user)
+template <typename T>
+class HistoryLog
+{
+public:
+   // create (or truncate) log file
+   HistoryLog(const std::string& path, int nbparam, int nbbit, int nbobjective = 1, int blocksize = 4096);
+   ~HistoryLog();
+
+   HistoryLog(const HistoryLog&) = delete;
+   HistoryLog& operator=(const HistoryLog&) = delete;
+
+   // record an evaluated chromosome, into block of calling thread (thread safe)
+   void record(const Chromosome<T>& chr);
+   // write all pending rows, must not be called while chromosomes are evaluated
+   void flush();
+
+   int nbparam() const { return (int)header.nbparam; }
+   int nbbit() const { return (int)header.nbbit; }
+   int nbobjective() const { return (int)header.nbobjective; }
+
+private:
+   // rows of one thread not written yet, stored by column
+   struct Block
+   {
+      std::vector<int32_t> generation;
+      std::vector<double> fitness;
+      std::vector<std::vector<double>> result;
+      std::vector<std::vector<T>> param;
+      std::vector<std::vector<uint64_t>> genome;
+      std::vector<uint64_t> words;           // packing buffer
+      std::vector<char> bytes;               // serialization buffer
+   };
+
+   HistoryHeader header;
+   int blocksize;
+   int nbword;
+   FILE* file = nullptr;
+   std::mutex mtx;                           // protects file
+   PerThread<Block> blocks;
+
+   Block& block();
+   void write(Block& b);
+};
+
+/*-------------------------------------------------------------------------------------------------*/
+
+// constructor
+template <typename T>
+HistoryLog<T>::HistoryLog(const std::string& path, int nbparam, int nbbit, int nbobjective, int blocksize)
+   : blocksize(blocksize), nbword((nbbit + 63) / 64)
+{
+   if (nbparam <= 0 || nbbit <= 0 || nbobjective <= 0 || blocksize <= 0) {
+      throw std::invalid_argument("Error: in class galgo::HistoryLog<T>, number of parameters, bits, objectives and block size must be > 0, please adjust.");
+   }
+   std::memcpy(header.magic, HISTORY_MAGIC, sizeof(HISTORY_MAGIC));
+   header.version = HISTORY_VERSION;
+   header.typesize = sizeof(T);
+   header.floating = std::is_floating_point<T>::value;
+   header.nbparam = nbparam;
+   header.nbbit = nbbit;
+   header.nbobjective = nbobjective;
+
+   file = std::fopen(path.c_str(), "wb");
+   if (file == nullptr || std::fwrite(&header, sizeof(header), 1, file) != 1) {
+      if (file != nullptr) std::fclose(file);
+      throw std::invalid_argument("Error: in class galgo::HistoryLog<T>, cannot create history file " + path + ", please check path.");
+   }
+}
+
+// destructor, writing pending rows
+template <typename T>
+HistoryLog<T>::~HistoryLog()
+{
+   flush();
+   std::fclose(file);
+}
+
+/*-------------------------------------------------------------------------------------------------*/
+
+// block of calling thread
+template <typename T>
+typename HistoryLog<T>::Block& HistoryLog<T>::block()
+{
+   return blocks.local([this](size_t) {
+      std::unique_ptr<Block> b(new Block);
+      b->result.resize(header.nbobjective);
+      b->param.resize(header.nbparam);
+      b->genome.resize(nbword);
+      b->words.resize(nbword + 1);
+      return b;
+   });
+}
+
+/*-------------------------------------------------------------------------------------------------*/
+
+// record an evaluated chromosome
+template <typename T>
+void HistoryLog<T>::record(const Chromosome<T>& chr)
+{
+   Block& b = block();
+
+   b.generation.push_back(chr.nogen_initial());
+   b.fitness.push_back(chr.fitness);
+
+   const std::vector<double>& result = chr.getResult();
+   for (size_t k = 0; k < b.result.size(); ++k) {
+      b.result[k].push_back(k < result.size() ? result[k] : std::numeric_limits<double>::quiet_NaN());
+   }
+   const std::vector<T>& param = chr.getParam();
+   for (size_t k = 0; k < b.param.size(); ++k) {
+      b.param[k].push_back(param[k]);
+   }
+   PackBits(chr.getBits(), b.words.data());
+   for (int w = 0; w < nbword; ++w) {
+      b.genome[w].push_back(b.words[w]);
+   }
+
+   if ((int)b.generation.size() >= blocksize) {
+      write(b);
+   }
+}
+
+/*-------------------------------------------------------------------------------------------------*/
+
+// append block rows to file as one block of columns, then empty it
+template <typename T>
+void HistoryLog<T>::write(Block& b)
+{
+   const size_t n = b.generation.size();
+   if (n == 0) return;
+
+   std::vector<char>& bytes = b.bytes;
+   bytes.clear();
+   auto append = [&bytes](const void* p, size_t size) {
+      const char* c = static_cast<const char*>(p);
+      bytes.insert(bytes.end(), c, c + size);
+      bytes.resize(bytes.size() + HistoryColumnSize(1, size) - size, 0);
+   };
+
+   HistoryBlockHeader bh;
+   bh.magic = HISTORY_BLOCK_MAGIC;
+   bh.nbrow = (uint32_t)n;
+   bh.size = 0;
+   append(&bh, sizeof(bh));
+   append(b.generation.data(), n * sizeof(int32_t));
+   append(b.fitness.data(), n * sizeof(double));
+   for (const auto& col : b.result) append(col.data(), n * sizeof(double));
+   for (const auto& col : b.param) append(col.data(), n * sizeof(T));
+   for (const auto& col : b.genome) append(col.data(), n * sizeof(uint64_t));
+   bh.size = bytes.size();
+   std::memcpy(bytes.data(), &bh, sizeof(bh));
+
+   {
+      std::lock_guard<std::mutex> lock(mtx);
+      if (std::fwrite(bytes.data(), 1, bytes.size(), file) != bytes.size()) {
+         throw std::invalid_argument("Error: in class galgo::HistoryLog<T>, cannot write history file, please check disk space.");
+      }
+   }
+
+   b.generation.clear();
+   b.fitness.clear();
+   for (auto& col : b.result) col.clear();
+   for (auto& col : b.param) col.clear();
+   for (auto& col : b.genome) col.clear();
+}
+
+/*-------------------------------------------------------------------------------------------------*/
+
+// write all pending rows
+template <typename T>
+void HistoryLog<T>::flush()
+{
+   std::vector<Block*> pending;
+   blocks.each([&pending](Block& b) { pending.push_back(&b); });
+   for (Block* b : pending) write(*b);
+
+   std::lock_guard<std::mutex> lock(mtx);
+   std::fflush(file);
+}
+
+/*-------------------------------------------------------------------------------------------------*/
+
+// columns of one block of a history file (pointers into mapped file)
+template <typename T>
+struct HistoryBlock
+{
+   int nbrow = 0;
+   const int32_t* generation = nullptr;
+   const double* fitness = nullptr;
+   std::vector<const double*> result;    // result[k][row]
+   std::vector<const T*> param;          // param[k][row]
+   std::vector<const uint64_t*> genome;  // genome[w][row]
+
+   // get bit b of genome of given row
+   bool bit(int row, int b) const { return (genome[b >> 6][row] >> (63 - (b & 63))) & 1; }
+};
+
+/*-------------------------------------------------------------------------------------------------*/
+
+// zero-copy reader of a history file: file is memory-mapped (read into memory on systems without mmap)
+// and blocks give direct pointers to their columns
+template <typename T>
+class HistoryReader
+{
+public:
+   HistoryReader(const std::string& path);
+   ~HistoryReader();
+
+   HistoryReader(const HistoryReader&) = delete;
+   HistoryReader& operator=(const HistoryReader&) = delete;
+
+   // number of blocks
+   int nbblock() const { return (int)blocks.size(); }
+   // columns of block i
+   const HistoryBlock<T>& block(int i) const { return blocks[i]; }
+   // total number of rows (evaluations)
+   uint64_t size() const { return nbrow; }
+
+   int nbparam() const { return (int)header.nbparam; }
+   int nbbit() const { return (int)header.nbbit; }
+   int nbobjective() const { return (int)header.nbobjective; }
+
+private:
+   HistoryHeader header;
+   const char* data = nullptr;
+   size_t length = 0;
+   uint64_t nbrow = 0;
+   std::vector<char> copy;                   // file content without mmap
+   std::vector<HistoryBlock<T>> blocks;
+};
+
+/*-------------------------------------------------------------------------------------------------*/
+
+// constructor, mapping file and indexing its blocks
+template <typename T>
+HistoryReader<T>::HistoryReader(const std::string& path)
+{
+   const std::string error = "Error: in class galgo::HistoryReader<T>, ";
+
+#if defined(GALGO_HISTORY_MMAP)
+   int fd = ::open(path.c_str(), O_RDONLY);
+   struct stat st;
+   if (fd < 0 || ::fstat(fd, &st) != 0) {
+      if (fd >= 0) ::close(fd);
+      throw std::invalid_argument(error + "cannot open history file " + path + ", please check path.");
+   }
+   length = (size_t)st.st_size;
+   if (length > 0) {
+      void* p = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (p == MAP_FAILED) {
+         ::close(fd);
+         throw std::invalid_argument(error + "cannot map history file " + path + ", please check path.");
+      }
+      data = static_cast<const char*>(p);
+   }
+   ::close(fd);
+#else
+   if (!ReadCheckpoint(path, copy)) {
+      throw std::invalid_argument(error + "cannot open history file " + path + ", please check path.");
+   }
+   data = copy.data();
+   length = copy.size();
+#endif
+
+   if (length < sizeof(header)) {
+      throw std::invalid_argument(error + path + " is not a history file, please adjust.");
+   }
+   std::memcpy(&header, data, sizeof(header));
+   if (std::memcmp(header.magic, HISTORY_MAGIC, sizeof(HISTORY_MAGIC)) != 0 || header.version != HISTORY_VERSION) {
+      throw std::invalid_argument(error + path + " is not a history file, please adjust.");
+   }
+   if (header.typesize != sizeof(T) || header.floating != (uint32_t)std::is_floating_point<T>::value) {
+      throw std::invalid_argument(error + "parameter type does not match history file " + path + ", please adjust.");
+   }
+
+   const int nbword = (header.nbbit + 63) / 64;
+   size_t pos = HistoryColumnSize(1, sizeof(header));
+   while (pos + sizeof(HistoryBlockHeader) <= length) {
+      HistoryBlockHeader bh;
+      std::memcpy(&bh, data + pos, sizeof(bh));
+      // stopping at a truncated last block (e.g. process killed while writing)
+      if (bh.magic != HISTORY_BLOCK_MAGIC || bh.size > length - pos) break;
+
+      // columns implied by number of rows must fit inside block
+      uint64_t size = HistoryColumnSize(1, sizeof(bh)) + HistoryColumnSize(bh.nbrow, sizeof(int32_t))
+         + (1 + (uint64_t)header.nbobjective + (uint64_t)nbword) * HistoryColumnSize(bh.nbrow, sizeof(double))
+         + (uint64_t)header.nbparam * HistoryColumnSize(bh.nbrow, sizeof(T));
+      if (bh.size < size) {
+         throw std::invalid_argument(error + "corrupted block in history file " + path + " (columns exceed block size), please adjust.");
+      }
+
+      HistoryBlock<T> b;
+      b.nbrow = (int)bh.nbrow;
+      const char* p = data + pos + HistoryColumnSize(1, sizeof(bh));
+      auto column = [&p, &bh](size_t size) { const char* c = p; p += HistoryColumnSize(bh.nbrow, size); return c; };
+      b.generation = reinterpret_cast<const int32_t*>(column(sizeof(int32_t)));
+      b.fitness = reinterpret_cast<const double*>(column(sizeof(double)));
+      for (uint32_t k = 0; k < header.nbobjective; ++k) b.result.push_back(reinterpret_cast<const double*>(column(sizeof(double))));
+      for (uint32_t k = 0; k < header.nbparam; ++k) b.param.push_back(reinterpret_cast<const T*>(column(sizeof(T))));
+      for (int w = 0; w < nbword; ++w) b.genome.push_back(reinterpret_cast<const uint64_t*>(column(sizeof(uint64_t))));
+
+      blocks.push_back(std::move(b));
+      nbrow += bh.nbrow;
+      pos += bh.size;
+   }
+}
+
+// destructor, unmapping file
+template <typename T>
+HistoryReader<T>::~HistoryReader()
+{
+#if defined(GALGO_HISTORY_MMAP)
+   if (data != nullptr) ::munmap(const_cast<char*>(data), length);
+#endif
+}
+
+//=================================================================================================
+
+}
+
+#endif
@@ -0,0 +1,138 @@
+//=================================================================================================
+//                  Copyright (C) 2018 Alain Lanthier - All Rights Reserved
+//                  License: MIT License    See LICENSE.md for the full license.
+//                  Original code 2017 Olivier Mallet (MIT License)
+//=================================================================================================
+
+#ifndef MEMORY_HPP
+#define MEMORY_HPP
+
+// Memory accounting of genetic algorithm components, enabled by compiling with GALGO_MEMORY:
+// without it chromosomes account nothing, GeneticAlgorithm<T> has no memory member and memorycap
+// is rejected.
+
+namespace galgo {
+
+//=================================================================================================
+
+// components of galgo memory footprint
+enum class MemoryComponent { Population, Chromosome, Genome, Param, Sigma, Result };
+
+const int NBMEMORY = 6;
+const char* const MEMORY_NAME[NBMEMORY] = { "population", "chromosome", "genome", "param", "sigma", "result" };
+
+// shared_ptr control block allocated with each chromosome by make_shared (vtable and two counts)
+const int64_t MEMORY_CONTROL_BLOCK = sizeof(void*) + 2 * sizeof(int);
+
+/*-------------------------------------------------------------------------------------------------*/
+
+// Bytes held by the components of one genetic algorithm (GeneticAlgorithm<T>::memory, compiled
+// with GALGO_MEMORY):
+//    population  pointer arrays of current, mating, new and late populations
+//    chromosome  chromosome objects with their shared_ptr control block
+//    genome      bit strings of chromosomes
+//    param       decoded parameters
+//    sigma       mutation step sizes and their update counts
+//    result      objective and constraint values
+// Chromosomes account the capacity of their containers when created, copied and evaluated, and
+// give it back when destroyed (chromosomes only point to the account, they must not outlive their
+// genetic algorithm). Every thread adds into its own counters (written by that thread only),
+// sample() merges them into current bytes and peaks, once per generation.
+class MemoryAccount
+{
+public:
+   MemoryAccount() {}
+
+   MemoryAccount(const MemoryAccount&) = delete;
+   MemoryAccount& operator=(const MemoryAccount&) = delete;
+
+   // add (or remove if negative) bytes to component, counters of calling thread
+   void add(MemoryComponent c, int64_t n);
+   // set bytes of component (thread calling sample() only)
+   void set(MemoryComponent c, int64_t n);
+   // merge counters of threads, update current bytes and peaks
+   void sample();
+   // restart peaks from current bytes
+   void restart();
+
+   // bytes and peaks at last sample()
+   int64_t current(MemoryComponent c) const { return bytes[static_cast<int>(c)]; }
+   int64_t peak(MemoryComponent c) const { return peaks[static_cast<int>(c)]; }
+   int64_t total() const { return sum; }
+   int64_t peakTotal() const { return peaksum; }
+
+   // write table of current and peak bytes of components
+   void summary(std::ostream& os) const;
+
+private:
+   struct Counters
+   {
+      std::atomic<int64_t> bytes[NBMEMORY];
+      Counters() { for (auto& b : bytes) b = 0; }
+   };
+
+   PerThread<Counters> counters;
+   int64_t assigned[NBMEMORY] = {};               // bytes set by set()
+   int64_t bytes[NBMEMORY] = {};
+   int64_t peaks[NBMEMORY] = {};
+   int64_t sum = 0;
+   int64_t peaksum = 0;
+};
+
+/*-------------------------------------------------------------------------------------------------*/
+
+// single writer per counter: relaxed load and store are enough
+inline void MemoryAccount::add(MemoryComponent c, int64_t n)
+{
+   Counters& local = counters.local([](size_t) { return std::unique_ptr<Counters>(new Counters); });
+   std::atomic<int64_t>& b = local.bytes[static_cast<int>(c)];
+   b.store(b.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+}
+
+inline void MemoryAccount::set(MemoryComponent c, int64_t n)
+{
+   assigned[static_cast<int>(c)] = n;
+}
+
+inline void MemoryAccount::sample()
+{
+   for (int c = 0; c < NBMEMORY; ++c) bytes[c] = assigned[c];
+   counters.each([this](const Counters& local) {
+      for (int c = 0; c < NBMEMORY; ++c) bytes[c] += local.bytes[c].load(std::memory_order_relaxed);
+   });
+   sum = 0;
+   for (int c = 0; c < NBMEMORY; ++c) {
+      peaks[c] = std::max(peaks[c], bytes[c]);
+      sum += bytes[c];
+   }
+   peaksum = std::max(peaksum, sum);
+}
+
+inline void MemoryAccount::restart()
+{
+   sample();
+   for (int c = 0; c < NBMEMORY; ++c) peaks[c] = bytes[c];
+   peaksum = sum;
+}
+
+/*-------------------------------------------------------------------------------------------------*/
+
+inline void MemoryAccount::summary(std::ostream& os) const
+{
+   os << "\n Memory (MB)\n";
+   os << " -------------------------------------\n";
+   os << " component     |      current |         peak\n";
+   for (int c = 0; c < NBMEMORY; ++c) {
+      os << " " << std::left << std::setw(13) << MEMORY_NAME[c] << std::right << " | "
+         << std::setw(12) << std::fixed << std::setprecision(3) << bytes[c] / 1048576.0 << " | "
+         << std::setw(12) << peaks[c] / 1048576.0 << "\n";
+   }
+   os << " " << std::left << std::setw(13) << "total" << std::right << " | "
+      << std::setw(12) << sum / 1048576.0 << " | " << std::setw(12) << peaksum / 1048576.0 << "\n\n";
+}
+
+//=================================================================================================
+
+}
+
+#endif
@@ -0,0 +1,127 @@
+//=================================================================================================
+//                  Copyright (C) 2018 Alain Lanthier - All Rights Reserved
+//                  License: MIT License    See LICENSE.md for the full license.
+//                  Original code 2017 Olivier Mallet (MIT License)
+//=================================================================================================
+
+#ifndef OBJECTIVE_HPP
+#define OBJECTIVE_HPP
+
+namespace galgo {
+
+//=================================================================================================
+
+// non owning view of contiguous elements
+template <typename T>
+class Span
+{
+public:
+   Span() {}
+   Span(T* data, size_t size) : ptr(data), count(size) {}
+
+   T& operator[](size_t i) const { return ptr[i]; }
+   T* data() const { return ptr; }
+   size_t size() const { return count; }
+   bool empty() const { return count == 0; }
+   T* begin() const { return ptr; }
+   T* end() const { return ptr + count; }
+
+private:
+   T* ptr = nullptr;
+   size_t count = 0;
+};
+
+/*-------------------------------------------------------------------------------------------------*/
+
+// scratch memory for objective functions: a bump allocator reset before each objective call,
+// its blocks are kept between calls so that after the first evaluations nothing is allocated
+class ScratchArena
+{
+public:
+   // allocate n uninitialized elements of type U, valid until the objective function returns
+   template <typename U>
+   U* allocate(size_t n)
+   {
+      return static_cast<U*>(allocate(n * sizeof(U), alignof(U)));
+   }
+
+   // allocate raw bytes
+   void* allocate(size_t bytes, size_t align)
+   {
+      for (;;) {
+         if (block < blocks.size()) {
+            size_t start = (offset + align - 1) / align * align;
+            if (start + bytes <= sizes[block]) {
+               offset = start + bytes;
+               return blocks[block].get() + start;
+            }
+            block++;
+            offset = 0;
+            continue;
+         }
+         // new block, at least doubling arena capacity
+         size_t size = std::max<size_t>(bytes + align, sizes.empty() ? 4096 : 2 * sizes.back());
+         blocks.emplace_back(new char[size]);
+         sizes.push_back(size);
+      }
+   }
+
+   // release all allocations (memory is kept)
+   void reset()
+   {
+      block = 0;
+      offset = 0;
+   }
+
+private:
+   std::vector<std::unique_ptr<char[]>> blocks;   // memory blocks
+   std::vector<size_t> sizes;                     // blocks size
+   size_t block = 0;                              // current block
+   size_t offset = 0;                             // first free byte in current block
+};
+
+// scratch arena of calling thread
+inline ScratchArena& ThreadScratch()
+{
+   static thread_local ScratchArena arena;
+   return arena;
+}
+
+/*-------------------------------------------------------------------------------------------------*/
+
+// allocation free objective function: parameters x, objective(s) result written into result
+// (nbobjective values), user context and per thread scratch memory supplied by galgo
+template <typename T>
+using SpanObjectiveFunc = void(*)(Span<const T> x, Span<double> result, void* context, ScratchArena& scratch);
+
+// allocation free objective bound to its context, as passed to Chromosome<T>::evaluate()
+template <typename T>
+struct SpanObjective
+{
+   SpanObjectiveFunc<T> function;
+   void* context;
+   int nbobjective;
+};
+
+/*-------------------------------------------------------------------------------------------------*/
+
+// objective function with early abort: bound is the total a chromosome needs to reach to be kept,
+// the objective may stop as soon as its total is known to end below bound, it then sets pruned
+// to true and returns partial result(s)
+template <typename T>
+using BoundedObjectiveFunc = std::vector<double>(*)(const std::vector<T>& x, double bound, bool& pruned);
+
+// early abort objective with bounds of current generation, as passed to Chromosome<T>::evaluate()
+template <typename T>
+struct BoundedObjective
+{
+   BoundedObjectiveFunc<T> function;
+   double bound;   // abort bound passed to objective
+   double floor;   // highest total given to a pruned chromosome (worst total of current population)
+};
+
+//=================================================================================================
+
+}
+
+#endif
@@ -0,0 +1,211 @@
+//=================================================================================================
+//                  Copyright (C) 2018 Alain Lanthier - All Rights Reserved
+//                  License: MIT License    See LICENSE.md for the full license.
+//                  Original code 2017 Olivier Mallet (MIT License)
+//=================================================================================================
+
+#ifndef PARETO_HPP
+#define PARETO_HPP
+
+namespace galgo {
+
+//=================================================================================================
+
+// return true if objective vector a Pareto dominates b (all objectives are maximized)
+inline bool dominates(const double* a, const double* b, int m)
+{
+   bool better = false;
+   for (int i = 0; i < m; ++i) {
+      if (a[i] < b[i]) return false;
+      if (a[i] > b[i]) better = true;
+   }
+   return better;
+}
+
+inline bool dominates(const std::vector<double>& a, const std::vector<double>& b)
+{
+   return dominates(a.data(), b.data(), (int)a.size());
+}
+
+/*-------------------------------------------------------------------------------------------------*/
+
+// fast non-dominated sorting (efficient non-dominated sort with binary search, ENS-BS)
+// f[i] points to the m objectives of solution i, front[i] receives its Pareto rank (0 = best)
+// return number of fronts
+// solutions are visited in decreasing lexicographic order so that a solution can only be dominated
+// by solutions already assigned, each one is placed with a binary search on the fronts (a solution
+// dominated by a member of front k is dominated by a member of every front before k)
+//    2 objectives: only the last solution of a front needs to be checked => O(N log N)
+//    3 objectives: first objective is already ordered, each front keeps the staircase of its
+//                  non-dominated points on the 2 other objectives in a balanced tree => O(N log^2 N)
+//    more objectives: the front is scanned backward => O(M N^2) in the worst case
+inline int NonDominatedSort(const std::vector<const double*>& f, int m, std::vector<int>& front)
+{
+   int n = (int)f.size();
+   front.assign(n, 0);
+   if (n == 0) return 0;
+
+   std::vector<int> order(n);
+   std::iota(order.begin(), order.end(), 0);
+   std::sort(order.begin(), order.end(), [&f, m](int i, int j)->bool {
+      return std::lexicographical_compare(f[j], f[j] + m, f[i], f[i] + m);
+   });
+
+   int nbfront = 0;
+   std::vector<std::vector<int>> fronts;
+   // 3 objectives: staircase of each front, second objective -> third objective (decreasing)
+   std::vector<std::map<double, double>> stairs;
+
+   // is solution p dominated by a member of front k
+   auto dominated = [&](int p, int k)->bool {
+      if (m == 3) {
+         // point with second and third objectives >= those of p (first one is >= by order)
+         auto it = stairs[k].lower_bound(f[p][1]);
+         return it != stairs[k].end() && it->second >= f[p][2];
+      }
+      const std::vector<int>& F = fronts[k];
+      if (m == 2) return dominates(f[F.back()], f[p], m);
+      for (int j = (int)F.size() - 1; j >= 0; --j) {
+         if (dominates(f[F[j]], f[p], m)) return true;
+      }
+      return false;
+   };
+
+   // add solution p to front k
+   auto add = [&](int p, int k) {
+      if (m == 3) {
+         if (k == nbfront) stairs.emplace_back();
+         // removing staircase points dominated by p, then inserting p
+         std::map<double, double>& S = stairs[k];
+         auto it = S.upper_bound(f[p][1]);
+         while (it != S.begin() && std::prev(it)->second <= f[p][2]) it = S.erase(std::prev(it));
+         S.emplace_hint(it, f[p][1], f[p][2]);
+      } else {
+         if (k == nbfront) fronts.emplace_back();
+         fronts[k].push_back(p);
+      }
+      if (k == nbfront) nbfront++;
+      front[p] = k;
+   };
+
+   for (size_t i = 0; i < order.size(); ++i) {
+      int p = order[i];
+      // identical solutions do not dominate each other and share a front
+      if (i > 0 && std::equal(f[p], f[p] + m, f[order[i - 1]])) {
+         front[p] = front[order[i - 1]];
+         continue;
+      }
+      int lo = 0;
+      int hi = nbfront;
+      while (lo < hi) {
+         int mid = (lo + hi) / 2;
+         if (dominated(p, mid)) lo = mid + 1;
+         else hi = mid;
+      }
+      add(p, lo);
+   }
+   return nbfront;
+}
+
+/*-------------------------------------------------------------------------------------------------*/
+
+// crowding distance of the solutions listed in members (one front)
+inline void CrowdingDistance(const std::vector<const double*>& f, int m, const std::vector<int>& members, std::vector<double>& crowding)
+{
+   int n = (int)members.size();
+   for (int i : members) crowding[i] = 0.0;
+   if (n <= 2) {
+      for (int i : members) crowding[i] = std::numeric_limits<double>::infinity();
+      return;
+   }
+
+   std::vector<int> sorted(members);
+   for (int k = 0; k < m; ++k) {
+      std::sort(sorted.begin(), sorted.end(), [&f, k](int i, int j)->bool{return f[i][k] < f[j][k];});
+
+      double fmin = f[sorted.front()][k];
+      double fmax = f[sorted.back()][k];
+      crowding[sorted.front()] = std::numeric_limits<double>::infinity();
+      crowding[sorted.back()] = std::numeric_limits<double>::infinity();
+      if (fmax == fmin) continue;
+
+      for (int j = 1; j < n - 1; ++j) {
+         crowding[sorted[j]] += (f[sorted[j + 1]][k] - f[sorted[j - 1]][k]) / (fmax - fmin);
+      }
+   }
+}
+
+/*-------------------------------------------------------------------------------------------------*/
+
+// NSGA-II ranking of a set of chromosomes: Pareto rank and crowding distance are set on each
+// chromosome and chromosomes are sorted with the crowded comparison operator
+// infeasible chromosomes (if any constraint) are ranked after all feasible ones by total violation
+// fitness is set to a scalar consistent with this order (-rank - 0.5/(1+crowding)) so that every
+// selection method can still be used
+template <typename T>
+void ParetoRanking(const GeneticAlgorithm<T>& ga, std::vector<CHR<T>>& pop)
+{
+   int n = (int)pop.size();
+   if (n == 0) return;
+
+   // constraint violation (feasible solutions are ranked first)
+   std::vector<double> violation(n, 0.0);
+   std::vector<int> feasible;
+   std::vector<int> infeasible;
+   for (int i = 0; i < n; ++i) {
+      if (ga.Constraint != nullptr) {
+         const std::vector<double>& cst = pop[i]->getConstraint();
+         if (std::any_of(cst.cbegin(), cst.cend(), [](double x)->bool{return x >= 0.0;})) {
+            for (double c : cst) violation[i] += std::max(0.0, c);
+            infeasible.push_back(i);
+            continue;
+         }
+      }
+      feasible.push_back(i);
+   }
+
+   // non-dominated sorting of feasible chromosomes
+   int m = feasible.empty() ? 0 : (int)pop[feasible[0]]->getResult().size();
+   std::vector<const double*> f(feasible.size());
+   for (size_t i = 0; i < feasible.size(); ++i) f[i] = pop[feasible[i]]->getResult().data();
+
+   std::vector<int> front;
+   int nbfront = NonDominatedSort(f, m, front);
+
+   std::vector<std::vector<int>> members(nbfront);
+   for (size_t i = 0; i < front.size(); ++i) members[front[i]].push_back((int)i);
+
+   std::vector<double> crowding(f.size());
+   for (const auto& F : members) CrowdingDistance(f, m, F, crowding);
+
+   for (size_t i = 0; i < feasible.size(); ++i) {
+      Chromosome<T>& chr = *pop[feasible[i]];
+      chr.rank = front[i];
+      chr.crowding = crowding[i];
+   }
+
+   // infeasible chromosomes, each violation level being its own front
+   std::sort(infeasible.begin(), infeasible.end(), [&violation](int i, int j)->bool{return violation[i] < violation[j];});
+   int rank = nbfront - 1;
+   for (size_t i = 0; i < infeasible.size(); ++i) {
+      if (i == 0 || violation[infeasible[i]] > violation[infeasible[i - 1]]) rank++;
+      pop[infeasible[i]]->rank = rank;
+      pop[infeasible[i]]->crowding = 0.0;
+   }
+
+   for (auto& chr : pop) {
+      chr->fitness = -chr->rank - 0.5 / (1.0 + chr->crowding);
+   }
+
+   // crowded comparison operator: lower rank first, then larger crowding distance
+   std::sort(pop.begin(), pop.end(), [](const CHR<T>& chr1, const CHR<T>& chr2)->bool {
+      if (chr1->rank != chr2->rank) return chr1->rank < chr2->rank;
+      return chr1->crowding > chr2->crowding;
+   });
+}
+
+//=================================================================================================
+
+}
+
+#endif
@@ -0,0 +1,504 @@
+//=================================================================================================
+//                  Copyright (C) 2018 Alain Lanthier - All Rights Reserved
+//                  License: MIT License    See LICENSE.md for the full license.
+//                  Original code 2017 Olivier Mallet (MIT License)
+//=================================================================================================
+
+#ifndef PARETOARCHIVE_HPP
+#define PARETOARCHIVE_HPP
+
+namespace galgo {
+
+//=================================================================================================
+
+// Bounded external archive of all non-dominated chromosomes found during a run (objectives are
+// maximized). Chromosomes are kept in an ND-tree (Jaszkiewicz & Lust 2018): every node stores the
+// ideal and nadir points bounding its chromosomes so that dominance queries and updates only
+// visit the branches whose box is comparable with the new objective vector.
+// When the archive exceeds its capacity, the most crowded chromosomes are discarded.
+// Hypervolume (relative to a reference point dominated by the solutions) is updated incrementally
+// for 2 objectives and recomputed lazily (only after changes) for more objectives.
+template <typename T>
+class ParetoArchive
+{
+public:
+   // constructor
+   ParetoArchive(int capacity = 1000, int leafsize = 20, int nbchild = 4);
+
+   // set reference point of hypervolume
+   void setReference(const std::vector<double>& ref);
+
+   // insert chromosome if not dominated, removing chromosomes it dominates, return true if inserted
+   bool insert(const CHR<T>& chr);
+
+   // return true if objective vector y is dominated by (or equal to) an archived chromosome
+   bool isDominated(const std::vector<double>& y) const;
+
+   // return archived chromosomes
+   std::vector<CHR<T>> solutions() const;
+
+   // return hypervolume dominated by archive
+   double hypervolume() const;
+
+   // return number of archived chromosomes
+   int size() const;
+
+   // remove all chromosomes
+   void clear();
+
+private:
+   struct Node
+   {
+      std::vector<double> ideal;                  // best value of each objective in this node
+      std::vector<double> nadir;                  // worst value of each objective in this node
+      std::vector<CHR<T>> points;                 // chromosomes (leaf)
+      std::vector<std::unique_ptr<Node>> children; // sub-nodes (internal node)
+   };
+
+   std::unique_ptr<Node> root;
+   std::vector<double> ref;                       // hypervolume reference point
+   std::map<double, double> front2d;              // 2 objectives front sorted on first objective (hypervolume)
+   mutable double hv = 0.0;                       // hypervolume
+   mutable bool hvdirty = false;                  // hypervolume must be recomputed (more than 2 objectives)
+   int capacity;
+   int leafsize;
+   int nbchild;
+   int count = 0;
+
+   static bool weaklyDominates(const std::vector<double>& a, const std::vector<double>& b);
+   static bool empty(const Node* n) { return n->points.empty() && n->children.empty(); }
+   static void extend(Node* n, const std::vector<double>& y);
+
+   bool isDominated(const Node* n, const std::vector<double>& y) const;
+   bool update(Node* n, const std::vector<double>& y);
+   void insert(Node* n, const CHR<T>& chr);
+   void split(Node* n);
+   void collect(const Node* n, std::vector<CHR<T>>& out) const;
+   void prune();
+
+   // hypervolume helpers
+   double contribution2d(std::map<double, double>::iterator it) const;
+   void insert2d(const std::vector<double>& y);
+   void erase2d(const std::vector<double>& y);
+   double hypervolume(std::vector<std::vector<double>>& pts, int m) const;
+};
+
+/*-------------------------------------------------------------------------------------------------*/
+
+// constructor
+template <typename T>
+ParetoArchive<T>::ParetoArchive(int capacity, int leafsize, int nbchild)
+   : root(new Node), capacity(capacity), leafsize(leafsize), nbchild(nbchild)
+{
+   if (capacity < 1 || leafsize < 2 || nbchild < 2) {
+      throw std::invalid_argument("Error: in class galgo::ParetoArchive<T>, capacity must be >= 1, leaf size and number of children >= 2, please adjust.");
+   }
+}
+
+/*-------------------------------------------------------------------------------------------------*/
+
+// set reference point of hypervolume, archived chromosomes not strictly better on all objectives do not contribute
+template <typename T>
+void ParetoArchive<T>::setReference(const std::vector<double>& r)
+{
+   ref = r;
+   front2d.clear();
+   hv = 0.0;
+   hvdirty = true;
+   if (ref.size() == 2) {
+      for (const auto& chr : solutions()) insert2d(chr->getResult());
+      hvdirty = false;
+   }
+}
+
+/*-------------------------------------------------------------------------------------------------*/
+
+// insert chromosome if not dominated by the archive
+template <typename T>
+bool ParetoArchive<T>::insert(const CHR<T>& chr)
+{
+   const std::vector<double>& y = chr->getResult();
+
+   if (!empty(root.get())) {
+      // rejecting dominated chromosome, removing chromosomes dominated by the new one
+      if (!update(root.get(), y)) return false;
+      if (empty(root.get())) root.reset(new Node);
+   }
+
+   insert(root.get(), chr);
+   count++;
+
+   if (ref.size() == 2) insert2d(y);
+   else hvdirty = true;
+
+   if (count > capacity) prune();
+
+   return true;
+}
+
+/*-------------------------------------------------------------------------------------------------*/
+
+// return true if objective vector y is dominated by (or equal to) an archived chromosome
+template <typename T>
+inline bool ParetoArchive<T>::isDominated(const std::vector<double>& y) const
+{
+   return !empty(root.get()) && isDominated(root.get(), y);
+}
+
+/*-------------------------------------------------------------------------------------------------*/
+
+// return archived chromosomes
+template <typename T>
+std::vector<CHR<T>> ParetoArchive<T>::solutions() const
+{
+   std::vector<CHR<T>> out;
+   out.reserve(count);
+   collect(root.get(), out);
+   return out;
+}
+
+/*-------------------------------------------------------------------------------------------------*/
+
+// return hypervolume dominated by archive
+template <typename T>
+double ParetoArchive<T>::hypervolume() const
+{
+   if (hvdirty) {
+      std::vector<std::vector<double>> pts;
+      for (const auto& chr : solutions()) {
+         const std::vector<double>& y = chr->getResult();
+         if (y.size() != ref.size()) continue;
+         std::vector<double> p(y.size());
+         bool contributes = true;
+         for (size_t k = 0; k < y.size(); ++k) {
+            p[k] = y[k] - ref[k];
+            if (p[k] <= 0.0) contributes = false;
+         }
+         if (contributes) pts.push_back(p);
+      }
+      hv = pts.empty() ? 0.0 : hypervolume(pts, (int)ref.size());
+      hvdirty = false;
+   }
+   return hv;
+}
+
+/*-------------------------------------------------------------------------------------------------*/
+
+// return number of archived chromosomes
+template <typename T>
+inline int ParetoArchive<T>::size() const
+{
+   return count;
+}
+
+/*-------------------------------------------------------------------------------------------------*/
+
+// remove all chromosomes
+template <typename T>
+void ParetoArchive<T>::clear()
+{
+   root.reset(new Node);
+   front2d.clear();
+   count = 0;
+   hv = 0.0;
+   hvdirty = false;
+}
+
+/*-------------------------------------------------------------------------------------------------*/
+
+// a weakly dominates b (a >= b on all objectives)
+template <typename T>
+inline bool ParetoArchive<T>::weaklyDominates(const std::vector<double>& a, const std::vector<double>& b)
+{
+   for (size_t i = 0; i < a.size(); ++i) {
+      if (a[i] < b[i]) return false;
+   }
+   return true;
+}
+
+/*-------------------------------------------------------------------------------------------------*/
+
+// extend node bounds to objective vector y
+template <typename T>
+void ParetoArchive<T>::extend(Node* n, const std::vector<double>& y)
+{
+   if (n->ideal.empty()) {
+      n->ideal = y;
+      n->nadir = y;
+      return;
+   }
+   for (size_t i = 0; i < y.size(); ++i) {
+      n->ideal[i] = std::max(n->ideal[i], y[i]);
+      n->nadir[i] = std::min(n->nadir[i], y[i]);
+   }
+}
+
+/*-------------------------------------------------------------------------------------------------*/
+
+// dominance query in node n
+template <typename T>
+bool ParetoArchive<T>::isDominated(const Node* n, const std::vector<double>& y) const
+{
+   // all chromosomes of node dominate y
+   if (weaklyDominates(n->nadir, y)) return true;
+   // no chromosome of node can dominate y
+   if (!weaklyDominates(n->ideal, y)) return false;
+
+   for (const auto& chr : n->points) {
+      if (weaklyDominates(chr->getResult(), y)) return true;
+   }
+   for (const auto& child : n->children) {
+      if (isDominated(child.get(), y)) return true;
+   }
+   return false;
+}
+
+/*-------------------------------------------------------------------------------------------------*/
+
+// remove chromosomes of node n dominated by y, return false if y is dominated
+// (bounds are not tightened after removal, they remain valid bounds)
+template <typename T>
+bool ParetoArchive<T>::update(Node* n, const std::vector<double>& y)
+{
+   // all chromosomes of node dominate y
+   if (weaklyDominates(n->nadir, y)) return false;
+
+   // y dominates all chromosomes of node
+   if (weaklyDominates(y, n->ideal) && y != n->ideal) {
+      std::vector<CHR<T>> removed;
+      collect(n, removed);
+      for (const auto& chr : removed) if (ref.size() == 2) erase2d(chr->getResult());
+      count -= (int)removed.size();
+      n->points.clear();
+      n->children.clear();
+      return true;
+   }
+
+   // node box not comparable with y
+   if (!weaklyDominates(n->ideal, y) && !weaklyDominates(y, n->nadir)) return true;
+
+   for (auto it = n->points.begin(); it != n->points.end();) {
+      const std::vector<double>& p = (*it)->getResult();
+      if (weaklyDominates(p, y)) return false;
+      if (weaklyDominates(y, p)) {
+         if (ref.size() == 2) erase2d(p);
+         it = n->points.erase(it);
+         count--;
+      } else {
+         ++it;
+      }
+   }
+   for (auto it = n->children.begin(); it != n->children.end();) {
+      if (!update(it->get(), y)) return false;
+      if (empty(it->get())) it = n->children.erase(it);
+      else ++it;
+   }
+   return true;
+}
+
+/*-------------------------------------------------------------------------------------------------*/
+
+// insert chromosome in node n (known to be non-dominated)
+template <typename T>
+void ParetoArchive<T>::insert(Node* n, const CHR<T>& chr)
+{
+   const std::vector<double>& y = chr->getResult();
+
+   while (!n->children.empty()) {
+      extend(n, y);
+
+      // choosing child whose box middle is closest to y
+      Node* best = nullptr;
+      double bestDist = std::numeric_limits<double>::max();
+      for (const auto& child : n->children) {
+         double dist = 0.0;
+         for (size_t i = 0; i < y.size(); ++i) {
+            double d = y[i] - 0.5 * (child->ideal[i] + child->nadir[i]);
+            dist += d * d;
+         }
+         if (dist < bestDist) {
+            bestDist = dist;
+            best = child.get();
+         }
+      }
+      n = best;
+   }
+
+   extend(n, y);
+   n->points.push_back(chr);
+   if ((int)n->points.size() > leafsize) split(n);
+}
+
+/*-------------------------------------------------------------------------------------------------*/
+
+// split leaf n into nbchild leaves (farthest point seeding)
+template <typename T>
+void ParetoArchive<T>::split(Node* n)
+{
+   int np = (int)n->points.size();
+   auto dist = [&n](int i, int j)->double {
+      const std::vector<double>& a = n->points[i]->getResult();
+      const std::vector<double>& b = n->points[j]->getResult();
+      double d = 0.0;
+      for (size_t k = 0; k < a.size(); ++k) d += (a[k] - b[k]) * (a[k] - b[k]);
+      return d;
+   };
+
+   // seeds: first point, then repeatedly the point farthest from all seeds
+   std::vector<int> seeds(1, 0);
+   std::vector<double> mindist(np);
+   for (int i = 0; i < np; ++i) mindist[i] = dist(i, 0);
+   while ((int)seeds.size() < nbchild) {
+      int far = (int)std::distance(mindist.begin(), std::max_element(mindist.begin(), mindist.end()));
+      if (mindist[far] == 0.0) break;
+      seeds.push_back(far);
+      for (int i = 0; i < np; ++i) mindist[i] = std::min(mindist[i], dist(i, far));
+   }
+
+   for (size_t s = 0; s < seeds.size(); ++s) n->children.emplace_back(new Node);
+
+   // assigning each point to closest seed
+   for (int i = 0; i < np; ++i) {
+      size_t best = 0;
+      for (size_t s = 1; s < seeds.size(); ++s) {
+         if (dist(i, seeds[s]) < dist(i, seeds[best])) best = s;
+      }
+      Node* child = n->children[best].get();
+      extend(child, n->points[i]->getResult());
+      child->points.push_back(n->points[i]);
+   }
+   n->points.clear();
+}
+
+/*-------------------------------------------------------------------------------------------------*/
+
+// collect chromosomes of node n
+template <typename T>
+void ParetoArchive<T>::collect(const Node* n, std::vector<CHR<T>>& out) const
+{
+   out.insert(out.end(), n->points.begin(), n->points.end());
+   for (const auto& child : n->children) collect(child.get(), out);
+}
+
+/*-------------------------------------------------------------------------------------------------*/
+
+// discard most crowded chromosomes down to 90% of capacity, then rebuild tree
+template <typename T>
+void ParetoArchive<T>::prune()
+{
+   std::vector<CHR<T>> all = solutions();
+   int n = (int)all.size();
+   int m = (int)all[0]->getResult().size();
+
+   std::vector<const double*> f(n);
+   for (int i = 0; i < n; ++i) f[i] = all[i]->getResult().data();
+
+   std::vector<int> members(n);
+   std::iota(members.begin(), members.end(), 0);
+   std::vector<double> crowding(n);
+   CrowdingDistance(f, m, members, crowding);
+
+   std::sort(members.begin(), members.end(), [&crowding](int i, int j)->bool{return crowding[i] > crowding[j];});
+   members.resize(std::max(1, capacity - capacity / 10));
+
+   root.reset(new Node);
+   front2d.clear();
+   hv = 0.0;
+   hvdirty = ref.size() != 2;
+   count = 0;
+   for (int i : members) {
+      insert(root.get(), all[i]);
+      count++;
+      if (ref.size() == 2) insert2d(all[i]->getResult());
+   }
+}
+
+/*-------------------------------------------------------------------------------------------------*/
+
+// exclusive hypervolume of a point of the 2 objectives front
+// (front sorted on first objective ascending, second objective is then descending)
+template <typename T>
+double ParetoArchive<T>::contribution2d(std::map<double, double>::iterator it) const
+{
+   double left = (it == front2d.begin()) ? ref[0] : std::prev(it)->first;
+   auto next = std::next(it);
+   double below = (next == front2d.end()) ? ref[1] : next->second;
+   return (it->first - left) * (it->second - below);
+}
+
+/*-------------------------------------------------------------------------------------------------*/
+
+// add non-dominated point to 2 objectives front, updating hypervolume
+template <typename T>
+void ParetoArchive<T>::insert2d(const std::vector<double>& y)
+{
+   if (y[0] <= ref[0] || y[1] <= ref[1]) return;
+
+   // removing points dominated by y (contiguous, just before y)
+   auto it = front2d.upper_bound(y[0]);
+   while (it != front2d.begin()) {
+      auto prev = std::prev(it);
+      if (prev->second > y[1]) break;
+      hv -= contribution2d(prev);
+      front2d.erase(prev);
+   }
+
+   it = front2d.emplace(y[0], y[1]).first;
+   hv += contribution2d(it);
+}
+
+/*-------------------------------------------------------------------------------------------------*/
+
+// remove point from 2 objectives front, updating hypervolume
+template <typename T>
+void ParetoArchive<T>::erase2d(const std::vector<double>& y)
+{
+   auto it = front2d.find(y[0]);
+   if (it == front2d.end() || it->second != y[1]) return;
+   hv -= contribution2d(it);
+   front2d.erase(it);
+}
+
+/*-------------------------------------------------------------------------------------------------*/
+
+// hypervolume of points (translated so that reference is 0) by slicing on last objective
+template <typename T>
+double ParetoArchive<T>::hypervolume(std::vector<std::vector<double>>& pts, int m) const
+{
+   if (m == 1) {
+      double v = 0.0;
+      for (const auto& p : pts) v = std::max(v, p[0]);
+      return v;
+   }
+   if (m == 2) {
+      std::sort(pts.begin(), pts.end(), [](const std::vector<double>& a, const std::vector<double>& b)->bool{return a[0] > b[0];});
+      double v = 0.0;
+      double top = 0.0;
+      for (const auto& p : pts) {
+         if (p[1] > top) {
+            v += p[0] * (p[1] - top);
+            top = p[1];
+         }
+      }
+      return v;
+   }
+
+   std::sort(pts.begin(), pts.end(), [m](const std::vector<double>& a, const std::vector<double>& b)->bool{return a[m - 1] > b[m - 1];});
+   double v = 0.0;
+   std::vector<std::vector<double>> slice;
+   for (size_t i = 0; i < pts.size(); ++i) {
+      slice.push_back(pts[i]);
+      double height = pts[i][m - 1] - ((i + 1 < pts.size()) ? pts[i + 1][m - 1] : 0.0);
+      if (height > 0.0) {
+         std::vector<std::vector<double>> sub(slice);
+         v += height * hypervolume(sub, m - 1);
+      }
+   }
+   return v;
+}
+
+//=================================================================================================
+
+}
+
+#endif
@@ -0,0 +1,87 @@
+//=================================================================================================
+//                  Copyright (C) 2018 Alain Lanthier - All Rights Reserved
+//                  License: MIT License    See LICENSE.md for the full license.
+//                  Original code 2017 Olivier Mallet (MIT License)
+//=================================================================================================
+
+#ifndef PERTHREAD_HPP
+#define PERTHREAD_HPP
+
+namespace galgo {
+
+//=================================================================================================
+
+// One instance of T per thread, owned by an object shared by threads (counters of MemoryAccount and
+// Profiler, blocks of HistoryLog, ring buffers of TraceLog): each thread gets its own instance on
+// first use, looked up under lock once per thread and owner, then through a thread_local cache.
+// Instances live until the owner is destroyed (a thread identifier reused by a new thread gets the
+// instance of the previous thread).
+template <typename T>
+class PerThread
+{
+public:
+   PerThread() { static std::atomic<uint64_t> counter(0); id = ++counter; }
+
+   PerThread(const PerThread&) = delete;
+   PerThread& operator=(const PerThread&) = delete;
+
+   // instance of calling thread, make(index) creates it when this thread identifier has none (index
+   // = number of instances created before), attach(instance) is called on every lookup under lock
+   template <typename M> T& local(const M& make) { return local(make, [](T&) {}); }
+   template <typename M, typename A> T& local(const M& make, const A& attach);
+
+   // call f(instance) for every instance in order of creation, no instance is created meanwhile
+   template <typename F> void each(const F& f);
+   template <typename F> void each(const F& f) const;
+
+private:
+   struct Cache { uint64_t id = 0; T* instance = nullptr; };
+
+   uint64_t id;                                   // unique identifier of this owner (thread caches)
+   mutable std::mutex mtx;                        // protects instances and index
+   std::vector<std::unique_ptr<T>> instances;     // in order of creation
+   std::map<std::thread::id, T*> index;
+
+   // instance last looked up by calling thread, one cache per thread and type
+   static Cache& cache() { static thread_local Cache c; return c; }
+};
+
+/*-------------------------------------------------------------------------------------------------*/
+
+template <typename T> template <typename M, typename A>
+T& PerThread<T>::local(const M& make, const A& attach)
+{
+   Cache& c = cache();
+   if (c.id == id) return *c.instance;
+
+   std::lock_guard<std::mutex> lock(mtx);
+   T*& p = index[std::this_thread::get_id()];
+   if (p == nullptr) {
+      instances.push_back(make(instances.size()));
+      p = instances.back().get();
+   }
+   attach(*p);
+   c.id = id;
+   c.instance = p;
+   return *p;
+}
+
+template <typename T> template <typename F>
+void PerThread<T>::each(const F& f)
+{
+   std::lock_guard<std::mutex> lock(mtx);
+   for (auto& p : instances) f(*p);
+}
+
+template <typename T> template <typename F>
+void PerThread<T>::each(const F& f) const
+{
+   std::lock_guard<std::mutex> lock(mtx);
+   for (const auto& p : instances) f(const_cast<const T&>(*p));
+}
+
+//=================================================================================================
+
+}
+
+#endif
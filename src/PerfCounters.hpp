@@ -0,0 +1,131 @@
+//=================================================================================================
+//                  Copyright (C) 2018 Alain Lanthier - All Rights Reserved
+//                  License: MIT License    See LICENSE.md for the full license.
+//                  Original code 2017 Olivier Mallet (MIT License)
+//=================================================================================================
+
+#ifndef PERFCOUNTERS_HPP
+#define PERFCOUNTERS_HPP
+
+#if defined(__linux__) && !defined(GALGO_NO_PERF_EVENT)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define GALGO_PERF_EVENT
+#endif
+
+namespace galgo {
+
+//=================================================================================================
+
+// hardware counters sampled by PerfGroup
+const int NBCOUNTER = 4;
+const char* const COUNTER_NAME[NBCOUNTER] = { "cycles", "instructions", "cache-misses", "branch-misses" };
+
+/*-------------------------------------------------------------------------------------------------*/
+
+// Group of Linux perf_event_open hardware counters of the thread opening it (user space only).
+// Not available (open() returns false) on other systems, or when kernel.perf_event_paranoid or
+// the container forbid it.
+class PerfGroup
+{
+public:
+   PerfGroup() { fd.fill(-1); }
+   ~PerfGroup() { close(); }
+
+   PerfGroup(const PerfGroup&) = delete;
+   PerfGroup& operator=(const PerfGroup&) = delete;
+
+   // open counters for calling thread (closing previous ones), return false if not available
+   bool open();
+   void close();
+   bool valid() const { return fd[0] >= 0; }
+   // true if opened by calling thread
+   bool current() const;
+
+   // read current counter values, scaled when counters were multiplexed
+   bool read(uint64_t* values) const;
+
+private:
+   std::array<int, NBCOUNTER> fd;
+   long tid = -1;                 // kernel thread identifier of opening thread
+};
+
+/*-------------------------------------------------------------------------------------------------*/
+
+inline bool PerfGroup::open()
+{
+   close();
+#ifdef GALGO_PERF_EVENT
+   const uint64_t config[NBCOUNTER] = { PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES };
+   for (int k = 0; k < NBCOUNTER; ++k) {
+      perf_event_attr attr;
+      std::memset(&attr, 0, sizeof(attr));
+      attr.size = sizeof(attr);
+      attr.type = PERF_TYPE_HARDWARE;
+      attr.config = config[k];
+      attr.disabled = k == 0;      // group starts with leader
+      attr.exclude_kernel = 1;
+      attr.exclude_hv = 1;
+      attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+      // calling thread, any cpu
+      fd[k] = (int)syscall(SYS_perf_event_open, &attr, 0, -1, k == 0 ? -1 : fd[0], 0);
+      if (fd[k] < 0) {
+         close();
+         return false;
+      }
+   }
+   ioctl(fd[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+   ioctl(fd[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+   tid = (long)syscall(SYS_gettid);
+   return true;
+#else
+   return false;
+#endif
+}
+
+inline void PerfGroup::close()
+{
+#ifdef GALGO_PERF_EVENT
+   for (int k = NBCOUNTER - 1; k >= 0; --k) {
+      if (fd[k] >= 0) ::close(fd[k]);
+   }
+#endif
+   fd.fill(-1);
+   tid = -1;
+}
+
+inline bool PerfGroup::current() const
+{
+#ifdef GALGO_PERF_EVENT
+   return valid() && tid == (long)syscall(SYS_gettid);
+#else
+   return false;
+#endif
+}
+
+/*-------------------------------------------------------------------------------------------------*/
+
+inline bool PerfGroup::read(uint64_t* values) const
+{
+#ifdef GALGO_PERF_EVENT
+   // number of counters, time enabled, time running, values
+   uint64_t data[3 + NBCOUNTER];
+   if (!valid() || ::read(fd[0], data, sizeof(data)) != (ssize_t)sizeof(data)) return false;
+   double scale = data[2] > 0 && data[2] < data[1] ? (double)data[1] / data[2] : 1.0;
+   for (int k = 0; k < NBCOUNTER; ++k) {
+      values[k] = (uint64_t)(data[3 + k] * scale);
+   }
+   return true;
+#else
+   (void)values;
+   return false;
+#endif
+}
+
+//=================================================================================================
+
+}
+
+#endif
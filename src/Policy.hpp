@@ -0,0 +1,91 @@
+//=================================================================================================
+//                  Copyright (C) 2018 Alain Lanthier - All Rights Reserved
+//                  License: MIT License    See LICENSE.md for the full license.
+//                  Original code 2017 Olivier Mallet (MIT License)
+//=================================================================================================
+
+#ifndef POLICY_HPP
+#define POLICY_HPP
+
+namespace galgo
+{
+    /*-------------------------------------------------------------------------------------------------*/
+    // Operator policies: wrap a selection, cross-over, mutation or objective function known at compile
+    // time into a functor type, so that the per-offspring calls can be inlined, e.g.
+    //    galgo::GeneticAlgorithm<double,
+    //        galgo::SelectionFn<double, TNT<double>>,
+    //        galgo::CrossOverFn<double, P1XO<double>>,
+    //        galgo::MutationFn<double, SPM<double>>,
+    //        galgo::ObjectiveFn<double, rastriginObjective<double>::Objective>> ga(config, par1, par2);
+    // Any functor type with the same call signature can be used as a policy.
+
+    template <typename T, void(*F)(Population<T>&)>
+    struct SelectionFn
+    {
+        void operator()(Population<T>& x) const { F(x); }
+    };
+
+    template <typename T, void(*F)(const Population<T>&, CHR<T>&, CHR<T>&)>
+    struct CrossOverFn
+    {
+        void operator()(const Population<T>& x, CHR<T>& chr1, CHR<T>& chr2) const { F(x, chr1, chr2); }
+    };
+
+    template <typename T, void(*F)(CHR<T>&)>
+    struct MutationFn
+    {
+        void operator()(CHR<T>& chr) const { F(chr); }
+    };
+
+    template <typename T, std::vector<double>(*F)(const std::vector<T>&)>
+    struct ObjectiveFn
+    {
+        std::vector<double> operator()(const std::vector<T>& x) const { return F(x); }
+    };
+
+    /*-------------------------------------------------------------------------------------------------*/
+    // Genetic algorithm with operators resolved at compile time.
+    // Configuration is the same as GeneticAlgorithm<T> but Selection, CrossOver, Mutation and Objective
+    // pointers are ignored: the policy instances below are used instead. Other objectives (BatchObjective,
+    // ObjectiveSpan, ObjectiveBounded) would bypass ObjectivePolicy and are rejected.
+    template <typename T, typename SelectionPolicy, typename CrossoverPolicy, typename MutationPolicy, typename ObjectivePolicy>
+    class GeneticAlgorithm<T, SelectionPolicy, CrossoverPolicy, MutationPolicy, ObjectivePolicy> : public GeneticAlgorithm<T>
+    {
+    public:
+        SelectionPolicy selection;
+        CrossoverPolicy crossover;
+        MutationPolicy mutation;
+        ObjectivePolicy objective;
+
+        // constructor
+        template <int...N> GeneticAlgorithm(const ConfigInfo<T>& config, const Parameter<T, N>&...args)
+            : GeneticAlgorithm<T>(config, args...)
+        {
+        }
+
+        template <int...N> GeneticAlgorithm(const ConfigInfo<T>& config, std::vector<T> init_values, const Parameter<T, N>&...args)
+            : GeneticAlgorithm<T>(config, init_values, args...)
+        {
+        }
+
+        // run genetic algorithm
+        void run() override
+        {
+            check();
+            GeneticAlgorithm<T>::run(selection, crossover, mutation, objective);
+        }
+
+    protected:
+        // check inputs validity
+        void check() const
+        {
+            GeneticAlgorithm<T>::check();
+
+            if (this->BatchObjective != nullptr || this->ObjectiveSpan != nullptr || this->ObjectiveBounded != nullptr) {
+                throw std::invalid_argument("Error: in class galgo::GeneticAlgorithm<T,Policies...>, objective is given by ObjectivePolicy (BatchObjective, ObjectiveSpan and ObjectiveBounded are not supported), please adjust.");
+            }
+        }
+    };
+}
+
+#endif
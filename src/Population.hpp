@@ -17,13 +17,34 @@ public:
    Population() {}
    // constructor
    Population(const GeneticAlgorithm<T>& ga);
+   // constructor of a local mating population (e.g. neighbourhood of a cellular GA cell)
+   Population(const GeneticAlgorithm<T>& ga, const std::vector<CHR<T>>& mates);
+   // replace mates of a local mating population (storage reused)
+   void mating(const CHR<T>& mate1, const CHR<T>& mate2);
 
    // create a population of chromosomes
    void creation();
    void creation(std::vector<T>& _init_values);
+   template <typename O> void creation(const O& objective);
+   template <typename O> void creation(std::vector<T>& _init_values, const O& objective);
 
    // evolve population, get next generation
    void evolution();
+   // evolve population with given operators (function pointers or functors resolved at compile time)
+   template <typename S, typename C, typename M, typename O>
+   void evolution(const S& selection, const C& crossover, const M& mutation, const O& objective);
+   // select mating population from current population with given selection method
+   template <typename S> void selecting(const S& selection);
+   // evaluate offspring whose evaluation is deferred and merge them into current population
+   void flush();
+   // decode current population into matrix x of popsize rows by nbparam columns
+   void decode(std::vector<T>& x) const;
+   // return bytes of pointer arrays and batch buffers (chromosomes excepted)
+   size_t footprint() const;
+   // write population state (checkpoint), offspring whose evaluation is deferred saved as genomes
+   void save(CheckpointWriter& out);
+   // read back population state written by save()
+   void load(CheckpointReader& in);
 
    // access element in current population at position pos
    const CHR<T>& operator()(int pos) const;
@@ -47,6 +68,8 @@ public:
 
    // get worst objective function total result from current population
    double getWorstTotal() const;
+   // return worst objective function total result of feasible chromosomes (lowest() if none)
+   double getWorstFeasibleTotal() const;
 
    // return population size
    int popsize() const;
@@ -75,12 +98,32 @@ private:
    int nbrcrov;                              // number of cross-over
    int matidx;                               // mating population index
 
+   int nblate = 0;                           // number of offspring whose evaluation is deferred (pipelining)
+   std::vector<CHR<T>> latepop;              // offspring of previous generation waiting for evaluation
+   bool latepending = false;                 // late population not evaluated yet
+   std::function<void(const std::vector<CHR<T>>&, int, int)> latework; // evaluation of late population with objective of its generation
+
+   double prunebound = std::numeric_limits<double>::lowest(); // abort bound of early abort objective
+   double prunefloor = std::numeric_limits<double>::max(); // highest total of pruned chromosomes
+
+   std::vector<T> batchx;                    // decoded parameters matrix (batch objective)
+   std::vector<std::vector<double>> batchres; // objective results (batch objective)
+
    // elitism => saving best chromosomes in new population
    void elitism();
    // create new population from recombination of the old one
-   void recombination();
+   template <typename C, typename M, typename O> void recombination(const C& crossover, const M& mutation, const O& objective);
    // complete new population randomly
-   void completion();
+   template <typename M, typename O> void completion(const M& mutation, const O& objective);
+   // swap new population tail with late population of previous generation, defer evaluation of tail
+   template <typename O> void pipelining(const O& objective);
+   // set evaluation of late population with objective
+   template <typename O> void deferring(const O& objective);
+   // objective used for this generation offspring: early abort objective gets current bounds
+   template <typename O> static const O& bounding(const O& objective) { return objective; }
+   BoundedObjective<T> bounding(const BoundedObjective<T>& objective) const;
+   // evaluate chromosomes pop[first...last-1] with batch objective
+   static void batching(const GeneticAlgorithm<T>& ga, const std::vector<CHR<T>>& pop, int first, int last, std::vector<T>& x, std::vector<std::vector<double>>& res);
 
 public:
    // update population (adapting, sorting)
@@ -102,6 +145,9 @@ Population<T>::Population(const GeneticAlgorithm<T>& ga)
    // for convenience, we add elitpop to nbrcrov
    nbrcrov += ga.elitpop;
 
+   // number of offspring whose evaluation overlaps next generation
+   nblate = (int)floor(ga.pipeline_ratio * (ga.popsize - ga.elitpop));
+
    // allocating memory
    curpop.resize(ga.popsize);
    matpop.resize(ga.matsize);
@@ -109,16 +155,52 @@ Population<T>::Population(const GeneticAlgorithm<T>& ga)
 
 /*-------------------------------------------------------------------------------------------------*/
 
+// constructor of a local mating population, only used by cross-over methods
+template <typename T>
+Population<T>::Population(const GeneticAlgorithm<T>& ga, const std::vector<CHR<T>>& mates)
+{
+   ptr = &ga;
+   nbrcrov = 0;
+   matidx = (int)mates.size();
+   matpop = mates;
+}
+
+/*-------------------------------------------------------------------------------------------------*/
+
+// replace mates of a local mating population
+template <typename T>
+void Population<T>::mating(const CHR<T>& mate1, const CHR<T>& mate2)
+{
+   matpop.resize(2);
+   matpop[0] = mate1;
+   matpop[1] = mate2;
+   matidx = 2;
+}
+
+/*-------------------------------------------------------------------------------------------------*/
+
 // create a population of chromosomes
 template <typename T>
 void Population<T>::creation()
+{
+   creation(ptr->Objective);
+}
+
+template <typename T>
+void Population<T>::creation(std::vector<T>& _init_values)
+{
+   creation(_init_values, ptr->Objective);
+}
+
+template <typename T> template <typename O>
+void Population<T>::creation(const O& objective)
 {
    int start = 0;
    // initializing first chromosome
    if (!ptr->initialSet.empty()) {
       curpop[0] = std::make_shared<Chromosome<T>>(*ptr);
       curpop[0]->initialize();
-      curpop[0]->evaluate();
+      if (ptr->BatchObjective == nullptr) curpop[0]->evaluate(objective);
       start++;
    }
    // getting the rest
@@ -128,14 +210,16 @@ void Population<T>::creation()
    for (int i = start; i < ptr->popsize; ++i) {
       curpop[i] = std::make_shared<Chromosome<T>>(*ptr);
       curpop[i]->create();
-      curpop[i]->evaluate();
+      if (ptr->BatchObjective == nullptr) curpop[i]->evaluate(objective);
    }
+   // evaluating whole population at once
+   if (ptr->BatchObjective != nullptr) batching(*ptr, curpop, 0, ptr->popsize, batchx, batchres);
    // updating population
    this->updating();
 }
 
-template <typename T>
-void Population<T>::creation(std::vector<T>& _init_values)
+template <typename T> template <typename O>
+void Population<T>::creation(std::vector<T>& _init_values, const O& objective)
 {
     int index = 0;
     int start = 0;
@@ -145,7 +229,7 @@ void Population<T>::creation(std::vector<T>& _init_values)
     {
         curpop[0] = std::make_shared<Chromosome<T>>(*ptr);
         curpop[0]->initialize();
-        curpop[0]->evaluate();
+        if (ptr->BatchObjective == nullptr) curpop[0]->evaluate(objective);
         start++;
     }
 
@@ -154,9 +238,12 @@ void Population<T>::creation(std::vector<T>& _init_values)
     {
         curpop[i] = std::make_shared<Chromosome<T>>(*ptr);
         curpop[i]->create(_init_values, index);
-        curpop[i]->evaluate();
+        if (ptr->BatchObjective == nullptr) curpop[i]->evaluate(objective);
     }
 
+    // evaluating whole population at once
+    if (ptr->BatchObjective != nullptr) batching(*ptr, curpop, 0, ptr->popsize, batchx, batchres);
+
     // updating population
     this->updating();
 }
@@ -167,30 +254,86 @@ void Population<T>::creation(std::vector<T>& _init_values)
 template <typename T>
 void Population<T>::evolution()
 {   
-   // initializing mating population index
-   matidx = 0;
+   evolution(ptr->Selection, ptr->CrossOver, ptr->Mutation, ptr->Objective);
+}
+
+template <typename T> template <typename S, typename C, typename M, typename O>
+void Population<T>::evolution(const S& selection, const C& crossover, const M& mutation, const O& unbounded)
+{   
+   // setting bounds of early abort objective (copied, late offspring keep bounds of their generation)
+   const auto objective = this->bounding(unbounded);
+
+   // late population read back from checkpoint: evaluated with objective of this generation
+   if (latepending && !latework) this->deferring(objective);
 
    // selecting mating population
    // curpop[] -> matpop[]
-   ptr->Selection(*this);
+   this->selecting(selection);
 
    // applying elitism if required
    // curpop[] -> newpop[0...elitpop-1]
-   this->elitism(); 
+   {
+      GALGO_STAGE(*ptr, Elitism);
+      this->elitism(); 
+   }
 
    // crossing-over mating population
    // matpop[] -> newpop[elitpop...nbrcrov-1]
-   this->recombination();
+   {
+      GALGO_STAGE(*ptr, Recombination);
+      this->recombination(crossover, mutation, objective);
+   }
 
    // completing new population
    // matpop[] -> newpop[nbrcrov...popsize]
-   this->completion();
+   {
+      GALGO_STAGE(*ptr, Completion);
+      this->completion(mutation, objective);
+   }
 
-   // moving new population into current population for next generation
-   curpop = std::move(newpop);
+   // evaluating new population at once with batch objective (except elit copies and late tail)
+   // newpop[elitpop...popsize-nblate]
+   if (ptr->BatchObjective != nullptr) {
+      GALGO_STAGE(*ptr, Evaluate);
+      TraceScope event(ptr->trace, "batch evaluate", ptr->nogen);
+      batching(*ptr, newpop, ptr->elitpop, ptr->popsize - nblate, batchx, batchres);
+   }
+
+   // pipelining evaluation of new population tail with next generation
+   // newpop[popsize-nblate...popsize] -> latepop[], previous latepop[] -> newpop[popsize-nblate...popsize]
+   if (nblate > 0) this->pipelining(objective);
+
+   if (ptr->multiobjective) {
+      // NSGA-II survival: parents and offspring (elit copies excepted) compete
+      curpop.insert(curpop.end(), newpop.begin() + ptr->elitpop, newpop.end());
+      newpop.clear();
+   } else {
+      // moving new population into current population for next generation
+      curpop = std::move(newpop);
+   }
 
    // updating population
-   this->updating(); 
+   {
+      GALGO_STAGE(*ptr, Updating);
+      this->updating(); 
+   }
+
+   // keeping best chromosomes only (multi-objective mode)
+   curpop.resize(ptr->popsize);
+}
+
+/*-------------------------------------------------------------------------------------------------*/
+
+// select mating population from current population
+template <typename T> template <typename S>
+void Population<T>::selecting(const S& selection)
+{
+   GALGO_STAGE(*ptr, Selection);
+   TraceScope event(ptr->trace, "selection", ptr->nogen);
+
+   // initializing mating population index
+   matidx = 0;
+   selection(*this);
 }
 
 /*-------------------------------------------------------------------------------------------------*/
@@ -216,13 +359,39 @@ void Population<T>::elitism()
 /*-------------------------------------------------------------------------------------------------*/
 
 // create new population from recombination of the old one
-template <typename T>
-void Population<T>::recombination()
+template <typename T> template <typename C, typename M, typename O>
+void Population<T>::recombination(const C& crossover, const M& mutation, const O& objective)
 {
    // creating a new population by cross-over
    #ifdef _OPENMP 
-   #pragma omp parallel for num_threads(MAX_THREADS)
+   #pragma omp parallel num_threads(MAX_THREADS)
    #endif
+   {
+      // late offspring of previous generation evaluated as tasks, picked up by threads waiting at barrier
+      if (latepending) {
+         #ifdef _OPENMP 
+         #pragma omp single nowait
+         #endif
+         {
+            int n = (int)latepop.size();
+            int step = ptr->BatchObjective != nullptr ? std::max(n, 1) : 1;
+            for (int i = 0; i < n; i += step) {
+               #ifdef _OPENMP 
+               #pragma omp task firstprivate(i)
+               #endif
+               {
+                  TraceScope event(ptr->trace, "late evaluate", ptr->nogen);
+                  latework(latepop, i, std::min(i + step, n));
+               }
+            }
+         }
+      }
+
+      // share of cross-over of this thread, then wait for other threads
+      TraceScope batch(ptr->trace, "crossover", ptr->nogen);
+      #ifdef _OPENMP 
+      #pragma omp for nowait
+      #endif
 
     //std::cout << "Gen(" << ptr->nogen << ") " << "Mating population after selection before recombination:"  << std::endl;
     //const galgo::Population<T>& x = *this;
@@ -238,29 +407,42 @@ void Population<T>::recombination()
     //    std::cout << "newpop[" << i << "]" << newpop[i]->fitness << std::endl;
     //}
 
-   for (int i = ptr->elitpop; i < nbrcrov; i = i + 2) 
-   {      
-      // initializing 2 new chromosome
-      newpop[i] = std::make_shared<Chromosome<T>>(*ptr);
-      newpop[i+1] = std::make_shared<Chromosome<T>>(*ptr);
-
-      // crossing-over mating population to create 2 new chromosomes
-      ptr->CrossOver(*this, newpop[i], newpop[i+1]);
-
-      // mutating new chromosomes
-      ptr->Mutation(newpop[i]);   
-      ptr->Mutation(newpop[i+1]);   
-
-      if (ptr->FixedValue != nullptr)
-      {
-          ptr->FixedValue(*this, i);
-          ptr->FixedValue(*this, i + 1);
-      }
-
-      // evaluating new chromosomes
-      newpop[i]->evaluate();
-      newpop[i+1]->evaluate();
-   } 
+      for (int i = ptr->elitpop; i < nbrcrov; i = i + 2) 
+      {      
+         // initializing 2 new chromosome
+         newpop[i] = std::make_shared<Chromosome<T>>(*ptr);
+         newpop[i+1] = std::make_shared<Chromosome<T>>(*ptr);
+
+         // crossing-over mating population to create 2 new chromosomes
+         crossover(*this, newpop[i], newpop[i+1]);
+
+         // mutating new chromosomes
+         mutation(newpop[i]);   
+         mutation(newpop[i+1]);   
+
+         if (ptr->FixedValue != nullptr)
+         {
+             GALGO_STAGE(*ptr, FixedValue);
+             ptr->FixedValue(*this, i);
+             ptr->FixedValue(*this, i + 1);
+         }
+
+         // evaluating new chromosomes (unless evaluation is pipelined or batched)
+         if (ptr->BatchObjective == nullptr) {
+            for (int j = i; j < i + 2 && j < ptr->popsize - nblate; ++j) {
+               GALGO_STAGE(*ptr, Evaluate);
+               TraceScope event(ptr->trace, "evaluate", ptr->nogen);
+               newpop[j]->evaluate(objective);
+            }
+         }
+      } 
+      batch.close();
+      TraceScope barrier(ptr->trace, "barrier", ptr->nogen);
+      #ifdef _OPENMP 
+      #pragma omp barrier
+      #endif
+   }
+   latepending = false;
 
    //std::cout << "Gen(" << ptr->nogen << ") " << "New individual created from crossover only  After recombination:" << std::endl;
    //for (int i = ptr->elitpop; i < nbrcrov; i++)
@@ -273,30 +455,245 @@ void Population<T>::recombination()
 /*-------------------------------------------------------------------------------------------------*/
 
 // complete new population
-template <typename T>
-void Population<T>::completion()
+template <typename T> template <typename M, typename O>
+void Population<T>::completion(const M& mutation, const O& objective)
 {
    #ifdef _OPENMP 
-   #pragma omp parallel for num_threads(MAX_THREADS)
+   #pragma omp parallel num_threads(MAX_THREADS)
    #endif
-   for (int i = nbrcrov; i < ptr->popsize; ++i)
    {
-      // selecting chromosome randomly from mating population
-      int pos = uniform<int>(0, ptr->matsize);
-      newpop[i] = std::make_shared<Chromosome<T>>(*matpop[pos]);
-      transmit_sigma<T>(*matpop[pos], *newpop[i]);
+      // share of completion of this thread, then wait for other threads
+      TraceScope batch(ptr->trace, "completion", ptr->nogen);
+      #ifdef _OPENMP 
+      #pragma omp for nowait
+      #endif
+      for (int i = nbrcrov; i < ptr->popsize; ++i)
+      {
+         // selecting chromosome randomly from mating population
+         int pos = uniform<int>(0, this->matsize());
+         newpop[i] = std::make_shared<Chromosome<T>>(*matpop[pos]);
+         transmit_sigma<T>(*matpop[pos], *newpop[i]);
+
+         // mutating chromosome
+         mutation(newpop[i]);
+
+         if (ptr->FixedValue != nullptr)
+         {
+             GALGO_STAGE(*ptr, FixedValue);
+             ptr->FixedValue(*this, i);
+         }
+
+         // evaluating chromosome (unless evaluation is pipelined or batched)
+         if (ptr->BatchObjective == nullptr && i < ptr->popsize - nblate) {
+            GALGO_STAGE(*ptr, Evaluate);
+            TraceScope event(ptr->trace, "evaluate", ptr->nogen);
+            newpop[i]->evaluate(objective);
+         }
+      }
+      batch.close();
+      TraceScope barrier(ptr->trace, "barrier", ptr->nogen);
+      #ifdef _OPENMP 
+      #pragma omp barrier
+      #endif
+   }
+}
 
-      // mutating chromosome
-      ptr->Mutation(newpop[i]);
+/*-------------------------------------------------------------------------------------------------*/
 
-      if (ptr->FixedValue != nullptr)
-      {
-          ptr->FixedValue(*this, i);
+// pipelining => evaluation of the last nblate offspring is deferred to the next generation, where
+// threads of the team idle at the end of recombination evaluate them as OpenMP tasks; they compete
+// when that next generation closes
+template <typename T> template <typename O>
+void Population<T>::pipelining(const O& objective)
+{
+   int start = ptr->popsize - nblate;
+   std::vector<CHR<T>> tail(newpop.begin() + start, newpop.end());
+
+   if (latepop.empty()) {
+      if (ptr->multiobjective) {
+         // first generation, NSGA-II survival: parents already compete, tail is left out
+         newpop.resize(start);
+      } else {
+         // first generation: no late result yet, keeping copies of best non elit survivors instead
+         std::transform(curpop.cbegin() + ptr->elitpop, curpop.cbegin() + ptr->elitpop + nblate, newpop.begin() + start, [](const CHR<T>& chr)->CHR<T>{return std::make_shared<Chromosome<T>>(*chr);});
+      }
+   } else {
+      // late offspring of previous generation are now evaluated, they compete in this generation
+      std::copy(latepop.cbegin(), latepop.cend(), newpop.begin() + start);
+   }
+
+   // deferring evaluation of this generation tail
+   latepop = std::move(tail);
+   latepending = true;
+   this->deferring(objective);
+}
+
+/*-------------------------------------------------------------------------------------------------*/
+
+// late population evaluated with a copy of objective (early abort objective keeps bounds of its generation)
+template <typename T> template <typename O>
+void Population<T>::deferring(const O& objective)
+{
+   const GeneticAlgorithm<T>* ga = ptr;
+   latework = [ga, objective](const std::vector<CHR<T>>& pop, int first, int last)->void {
+      if (ga->BatchObjective != nullptr) {
+         GALGO_STAGE(*ga, Evaluate);
+         std::vector<T> x;
+         std::vector<std::vector<double>> res;
+         batching(*ga, pop, first, last, x, res);
+         return;
+      }
+      for (int i = first; i < last; ++i) {
+         GALGO_STAGE(*ga, Evaluate);
+         TraceScope event(ga->trace, "evaluate", ga->nogen);
+         pop[i]->evaluate(objective);
       }
+   };
+}
+
+/*-------------------------------------------------------------------------------------------------*/
+
+// early abort objective with bounds computed by last update of current population
+template <typename T>
+BoundedObjective<T> Population<T>::bounding(const BoundedObjective<T>& objective) const
+{
+   return BoundedObjective<T>{ objective.function, prunebound, prunefloor };
+}
+
+/*-------------------------------------------------------------------------------------------------*/
 
-      // evaluating chromosome
-      newpop[i]->evaluate();
+// evaluate chromosomes pop[first...last-1] with batch objective: decoding all of them in one pass
+// into a matrix, calling batch objective once, then copying back parameters and results
+template <typename T>
+void Population<T>::batching(const GeneticAlgorithm<T>& ga, const std::vector<CHR<T>>& pop, int first, int last, std::vector<T>& x, std::vector<std::vector<double>>& res)
+{
+   int n = last - first;
+   if (n <= 0) return;
+
+   BulkDecode(pop, first, last, ga.idx, x);
+
+   // constraint-first mode: infeasible rows are dropped from the matrix before batch objective
+   std::vector<int> rows;
+   if (ga.constraintfirst) {
+      for (int i = 0; i < n; ++i) {
+         const T* values = x.data() + (size_t)i * ga.nbparam;
+         if (pop[first + i]->screen(values)) continue;
+         std::copy(values, values + ga.nbparam, x.begin() + rows.size() * ga.nbparam);
+         rows.push_back(i);
+      }
+      n = (int)rows.size();
+      if (n == 0) return;
+      x.resize((size_t)n * ga.nbparam);
    }
+
+   res.resize(n);
+   ga.BatchObjective(x, ga.nbparam, res);
+
+   for (int i = 0; i < n; ++i) {
+      pop[first + (rows.empty() ? i : rows[i])]->evaluate(x.data() + (size_t)i * ga.nbparam, res[i]);
+   }
+}
+
+/*-------------------------------------------------------------------------------------------------*/
+
+// decode current population into matrix x of popsize rows by nbparam columns
+template <typename T>
+void Population<T>::decode(std::vector<T>& x) const
+{
+   BulkDecode(curpop, 0, (int)curpop.size(), ptr->idx, x);
+}
+
+/*-------------------------------------------------------------------------------------------------*/
+
+// return bytes of pointer arrays and batch buffers (chromosomes excepted)
+template <typename T>
+size_t Population<T>::footprint() const
+{
+   size_t n = (curpop.capacity() + matpop.capacity() + newpop.capacity() + latepop.capacity()) * sizeof(CHR<T>);
+   n += batchx.capacity() * sizeof(T);
+   for (const auto& res : batchres) n += sizeof(res) + res.capacity() * sizeof(double);
+   return n;
+}
+
+/*-------------------------------------------------------------------------------------------------*/
+
+// write population state: current population, late offspring of pipelining (as genomes when
+// their evaluation is still deferred), plus bounds of early abort objective
+template <typename T>
+void Population<T>::save(CheckpointWriter& out)
+{
+   bool evaluated = !latepending;
+
+   out.put(prunebound);
+   out.put(prunefloor);
+   out.put<uint64_t>(curpop.size());
+   for (const auto& chr : curpop) chr->save(out);
+   out.put<uint8_t>(evaluated);
+   out.put<uint64_t>(latepop.size());
+   for (const auto& chr : latepop) {
+      if (evaluated) chr->save(out);
+      else chr->saveGenome(out);
+   }
+}
+
+// read back population state, late offspring saved as genomes are evaluated by next generation
+template <typename T>
+void Population<T>::load(CheckpointReader& in)
+{
+   in.get(prunebound);
+   in.get(prunefloor);
+   uint8_t evaluated = 1;
+   for (auto pop : { &curpop, &latepop }) {
+      if (pop == &latepop) in.get(evaluated);
+      uint64_t n;
+      in.get(n);
+      if (n > (uint64_t)ptr->popsize) {
+         throw std::invalid_argument("Error: in class galgo::Population<T>, checkpoint population does not match population size, please adjust.");
+      }
+      pop->resize((size_t)n);
+      for (auto& chr : *pop) {
+         chr = std::make_shared<Chromosome<T>>(*ptr);
+         if (evaluated) chr->load(in);
+         else chr->loadGenome(in);
+      }
+   }
+   latepending = !evaluated && !latepop.empty();
+   latework = nullptr;
+   if ((int)curpop.size() != ptr->popsize || (int)latepop.size() > nblate) {
+      throw std::invalid_argument("Error: in class galgo::Population<T>, checkpoint population does not match population size, please adjust.");
+   }
+}
+
+/*-------------------------------------------------------------------------------------------------*/
+
+// evaluate offspring whose evaluation is still deferred and merge them into current population
+template <typename T>
+void Population<T>::flush()
+{
+   if (latepending) {
+      if (latework) {
+         int n = (int)latepop.size();
+         int step = ptr->BatchObjective != nullptr ? std::max(n, 1) : 1;
+         #ifdef _OPENMP 
+         #pragma omp parallel for schedule(dynamic) num_threads(MAX_THREADS)
+         #endif
+         for (int i = 0; i < n; i += step) {
+            TraceScope event(ptr->trace, "late evaluate", ptr->nogen);
+            latework(latepop, i, std::min(i + step, n));
+         }
+      } else {
+         // late offspring read back from checkpoint as genomes, run resumed at its end (objective unknown)
+         latepop.clear();
+      }
+      latepending = false;
+   }
+   if (latepop.empty()) return;
+
+   // late offspring compete with current population, worst chromosomes are discarded
+   curpop.insert(curpop.end(), latepop.begin(), latepop.end());
+   latepop.clear();
+   this->updating();
+   curpop.resize(ptr->popsize);
 }
 
 /*-------------------------------------------------------------------------------------------------*/
@@ -307,10 +704,45 @@ void Population<T>::updating()
 {
    // adapting population to constraints
    if (ptr->Constraint != nullptr) {
+      TraceScope event(ptr->trace, "adaptation", ptr->nogen);
       ptr->Adaptation(*this); 
    }
-   // sorting chromosomes from best to worst fitness
-   std::sort(curpop.begin(),curpop.end(),[](const CHR<T>& chr1,const CHR<T>& chr2)->bool{return chr1->fitness > chr2->fitness;});
+   TraceScope sort(ptr->trace, "sort", ptr->nogen);
+   if (ptr->multiobjective) {
+      // ranking and sorting chromosomes by Pareto front and crowding distance
+      ParetoRanking(*ptr, curpop);
+   } else {
+      // sorting chromosomes from best to worst fitness
+      std::sort(curpop.begin(),curpop.end(),[](const CHR<T>& chr1,const CHR<T>& chr2)->bool{return chr1->fitness > chr2->fitness;});
+
+      // bounds for next generation early abort objective: total of chromosome at prune rank
+      // (worst one by default), pruned chromosomes being given at most the worst total, both
+      // clamped to feasible chromosomes (chromosomes screened out by constraintfirst have lowest()
+      // total), no pruning while no chromosome is feasible
+      if (ptr->ObjectiveBounded != nullptr) {
+         double worst = getWorstFeasibleTotal();
+         if (worst == std::numeric_limits<double>::lowest()) {
+            prunefloor = std::numeric_limits<double>::max();
+            prunebound = std::numeric_limits<double>::lowest();
+         } else {
+            prunefloor = worst;
+            prunebound = ptr->prunerank > 0 ? std::max(curpop[ptr->prunerank - 1]->getTotal(), worst) : worst;
+         }
+      }
+   }
+   sort.close();
+   // archiving non-dominated feasible chromosomes
+   if (ptr->archive != nullptr) {
+      TraceScope event(ptr->trace, "archive", ptr->nogen);
+      for (const auto& chr : curpop) {
+         if (chr->pruned) continue;
+         if (ptr->Constraint != nullptr) {
+            const std::vector<double>& cst = chr->getConstraint();
+            if (std::any_of(cst.cbegin(), cst.cend(), [](double x)->bool{return x >= 0.0;})) continue;
+         }
+         ptr->archive->insert(chr);
+      }
+   }
 }
 
 /*-------------------------------------------------------------------------------------------------*/
@@ -335,7 +767,7 @@ template <typename T>
 const CHR<T>& Population<T>::operator[](int pos) const
 {
    #ifndef NDEBUG
-   if (pos > ptr->matsize - 1) {
+   if (pos > this->matsize() - 1) {
       throw std::invalid_argument("Error: in galgo::Population<T>::operator[](int), exceeding mating population memory.");
    }
    #endif
@@ -389,7 +821,7 @@ inline void Population<T>::select(int pos)
    if (pos > ptr->popsize - 1) {
       throw std::invalid_argument("Error: in galgo::Population<T>::select(int), exceeding current population memory.");
    }
-   if (matidx == ptr->matsize) {
+   if (matidx == this->matsize()) {
       throw std::invalid_argument("Error: in galgo::Population<T>::select(int), exceeding mating population memory.");
    }
    #endif
@@ -440,6 +872,22 @@ inline double Population<T>::getWorstTotal() const
 
 /*-------------------------------------------------------------------------------------------------*/
 
+// get worst objective function total result of feasible chromosomes in current population
+template <typename T>
+inline double Population<T>::getWorstFeasibleTotal() const
+{
+   double worst = std::numeric_limits<double>::lowest();
+   bool found = false;
+   for (const auto& chr : curpop) {
+      if (!chr->feasible() || chr->getTotal() == std::numeric_limits<double>::lowest()) continue;
+      worst = found ? std::min(worst, chr->getTotal()) : chr->getTotal();
+      found = true;
+   }
+   return worst;
+}
+
+/*-------------------------------------------------------------------------------------------------*/
+
 // return population size
 template <typename T>
 inline int Population<T>::popsize() const
@@ -453,7 +901,7 @@ inline int Population<T>::popsize() const
 template <typename T>
 inline int Population<T>::matsize() const
 {
-   return ptr->matsize;
+   return (int)matpop.size();
 }
 
 /*-------------------------------------------------------------------------------------------------*/
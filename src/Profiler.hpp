@@ -0,0 +1,316 @@
+//=================================================================================================
+//                  Copyright (C) 2018 Alain Lanthier - All Rights Reserved
+//                  License: MIT License    See LICENSE.md for the full license.
+//                  Original code 2017 Olivier Mallet (MIT License)
+//=================================================================================================
+
+#ifndef PROFILER_HPP
+#define PROFILER_HPP
+
+// Stage timing of the generation loop, enabled by compiling with GALGO_PROFILE: without it
+// GALGO_STAGE() expands to nothing and GeneticAlgorithm<T> has no profiler member.
+#ifdef GALGO_PROFILE
+#define GALGO_CONCAT_(a, b) a##b
+#define GALGO_CONCAT(a, b) GALGO_CONCAT_(a, b)
+// time enclosing scope as given stage of profiler of genetic algorithm ga
+#define GALGO_STAGE(ga, stage) galgo::StageTimer GALGO_CONCAT(stagetimer, __LINE__)((ga).profiler, galgo::Stage::stage)
+#else
+#define GALGO_STAGE(ga, stage)
+#endif
+
+namespace galgo {
+
+//=================================================================================================
+
+// stages of Population<T>::evolution(), Recombination and Completion include Evaluate and FixedValue
+// of the offspring they create
+enum class Stage { Selection, Elitism, Recombination, Completion, Evaluate, FixedValue, Updating };
+
+const int NBSTAGE = 7;
+const char* const STAGE_NAME[NBSTAGE] = { "selection", "elitism", "recombination", "completion", "evaluate", "fixedvalue", "updating" };
+
+// accumulated time of one stage
+struct StageTime
+{
+   double wall = 0.0;   // wall time (seconds)
+   double cpu = 0.0;    // CPU time of timing threads (seconds)
+   uint64_t count = 0;  // number of timed calls
+   double hw[NBCOUNTER] = {};  // hardware counters (see Profiler::counting())
+};
+
+typedef std::array<StageTime, NBSTAGE> StageTimes;
+
+/*-------------------------------------------------------------------------------------------------*/
+
+// wall clock (nanoseconds)
+inline int64_t WallTime()
+{
+   return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// CPU time of calling thread (nanoseconds), 0 where not available
+inline int64_t ThreadCpuTime()
+{
+#ifdef CLOCK_THREAD_CPUTIME_ID
+   timespec ts;
+   clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+   return (int64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+#else
+   return 0;
+#endif
+}
+
+/*-------------------------------------------------------------------------------------------------*/
+
+// Per thread and per generation stage timings: every thread accumulates into its own counters
+// (written by that thread only), generation() takes the difference since previous generation.
+// Hardware counters of each thread (PerfGroup) are also sampled around stages once counting(true).
+class Profiler
+{
+   friend class StageTimer;
+
+public:
+   Profiler() {}
+
+   Profiler(const Profiler&) = delete;
+   Profiler& operator=(const Profiler&) = delete;
+
+   // enable/disable sampling of hardware counters
+   void counting(bool enable) { hwcounting = enable; }
+   bool counting() const { return hwcounting; }
+   // close current generation, return its stage times (summed over threads)
+   const StageTimes& generation();
+   // clear all timings
+   void reset();
+
+   // stage times of every closed generation
+   const std::vector<StageTimes>& generations() const { return pergen; }
+   // stage times summed over threads since reset
+   StageTimes total() const;
+   // stage times of each thread since reset, in order of first use
+   std::vector<StageTimes> threads() const;
+   // write summary table
+   void summary(std::ostream& os) const;
+
+private:
+   struct Counters
+   {
+      std::atomic<int64_t> wall[NBSTAGE];
+      std::atomic<int64_t> cpu[NBSTAGE];
+      std::atomic<uint64_t> count[NBSTAGE];
+      std::atomic<uint64_t> hw[NBSTAGE][NBCOUNTER];
+      PerfGroup group;                            // hardware counters of thread
+      bool opened = false;                        // opening group attempted
+      Counters() { clear(); }
+      void clear();
+      // read hardware counters, opening them on first use
+      bool sample(uint64_t* values);
+   };
+
+   PerThread<Counters> counters;                  // in order of first use
+   StageTimes last;                               // total at end of previous generation
+   std::vector<StageTimes> pergen;
+   std::atomic<bool> hwcounting{false};
+
+   Counters& local();
+   // add time of stage to thread counters, hardware counters when start and end are given
+   static void add(Counters& c, Stage stage, int64_t wall, int64_t cpu, const uint64_t* start, const uint64_t* end);
+   static StageTimes times(const Counters& c);
+};
+
+/*-------------------------------------------------------------------------------------------------*/
+
+// scope timer of one stage, hardware counters are read innermost
+class StageTimer
+{
+public:
+   StageTimer(Profiler& profiler, Stage stage) : counters(profiler.local()), stage(stage)
+   {
+      wall = WallTime();
+      cpu = ThreadCpuTime();
+      hw = profiler.counting() && counters.sample(start);
+   }
+   ~StageTimer()
+   {
+      uint64_t end[NBCOUNTER];
+      bool ok = hw && counters.group.read(end);
+      Profiler::add(counters, stage, WallTime() - wall, ThreadCpuTime() - cpu, ok ? start : nullptr, end);
+   }
+
+   StageTimer(const StageTimer&) = delete;
+   StageTimer& operator=(const StageTimer&) = delete;
+
+private:
+   Profiler::Counters& counters;
+   Stage stage;
+   int64_t wall;
+   int64_t cpu;
+   bool hw;
+   uint64_t start[NBCOUNTER];
+};
+
+/*-------------------------------------------------------------------------------------------------*/
+
+inline void Profiler::Counters::clear()
+{
+   for (int s = 0; s < NBSTAGE; ++s) {
+      wall[s] = 0;
+      cpu[s] = 0;
+      count[s] = 0;
+      for (int k = 0; k < NBCOUNTER; ++k) hw[s][k] = 0;
+   }
+}
+
+inline bool Profiler::Counters::sample(uint64_t* values)
+{
+   if (!opened) {
+      opened = true;
+      group.open();
+   }
+   return group.read(values);
+}
+
+// counters of calling thread
+inline Profiler::Counters& Profiler::local()
+{
+   return counters.local([](size_t) { return std::unique_ptr<Counters>(new Counters); }, [](Counters& c) {
+      // thread identifier reused by a new thread: hardware counters of previous one are reopened
+      if (c.group.valid() && !c.group.current()) {
+         c.group.close();
+         c.opened = false;
+      }
+   });
+}
+
+// single writer per counter: relaxed load and store are enough
+inline void Profiler::add(Counters& c, Stage stage, int64_t wall, int64_t cpu, const uint64_t* start, const uint64_t* end)
+{
+   int s = static_cast<int>(stage);
+   c.wall[s].store(c.wall[s].load(std::memory_order_relaxed) + wall, std::memory_order_relaxed);
+   c.cpu[s].store(c.cpu[s].load(std::memory_order_relaxed) + cpu, std::memory_order_relaxed);
+   c.count[s].store(c.count[s].load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+   if (start == nullptr) return;
+   for (int k = 0; k < NBCOUNTER; ++k) {
+      // scaled (multiplexed) counters may go slightly backwards
+      uint64_t d = end[k] > start[k] ? end[k] - start[k] : 0;
+      c.hw[s][k].store(c.hw[s][k].load(std::memory_order_relaxed) + d, std::memory_order_relaxed);
+   }
+}
+
+/*-------------------------------------------------------------------------------------------------*/
+
+inline StageTimes Profiler::times(const Counters& c)
+{
+   StageTimes t;
+   for (int s = 0; s < NBSTAGE; ++s) {
+      t[s].wall = c.wall[s].load(std::memory_order_relaxed) * 1e-9;
+      t[s].cpu = c.cpu[s].load(std::memory_order_relaxed) * 1e-9;
+      t[s].count = c.count[s].load(std::memory_order_relaxed);
+      for (int k = 0; k < NBCOUNTER; ++k) t[s].hw[k] = (double)c.hw[s][k].load(std::memory_order_relaxed);
+   }
+   return t;
+}
+
+inline StageTimes Profiler::total() const
+{
+   StageTimes t;
+   for (const StageTimes& u : threads()) {
+      for (int s = 0; s < NBSTAGE; ++s) {
+         t[s].wall += u[s].wall;
+         t[s].cpu += u[s].cpu;
+         t[s].count += u[s].count;
+         for (int k = 0; k < NBCOUNTER; ++k) t[s].hw[k] += u[s].hw[k];
+      }
+   }
+   return t;
+}
+
+inline std::vector<StageTimes> Profiler::threads() const
+{
+   std::vector<StageTimes> t;
+   counters.each([&t](const Counters& c) { t.push_back(times(c)); });
+   return t;
+}
+
+/*-------------------------------------------------------------------------------------------------*/
+
+inline const StageTimes& Profiler::generation()
+{
+   StageTimes t = total();
+   StageTimes g;
+   for (int s = 0; s < NBSTAGE; ++s) {
+      g[s].wall = t[s].wall - last[s].wall;
+      g[s].cpu = t[s].cpu - last[s].cpu;
+      g[s].count = t[s].count - last[s].count;
+      for (int k = 0; k < NBCOUNTER; ++k) g[s].hw[k] = t[s].hw[k] - last[s].hw[k];
+   }
+   last = t;
+   pergen.push_back(g);
+   return pergen.back();
+}
+
+// must not be called while stages are timed
+inline void Profiler::reset()
+{
+   counters.each([](Counters& c) { c.clear(); });
+   last = StageTimes();
+   pergen.clear();
+}
+
+/*-------------------------------------------------------------------------------------------------*/
+
+inline void Profiler::summary(std::ostream& os) const
+{
+   StageTimes t = total();
+   std::vector<StageTimes> u = threads();
+
+   os << "\n Stage timings (" << pergen.size() << " generations, " << u.size() << " threads)\n";
+   os << " ---------------------------------------------------------------\n";
+   os << " stage         |     wall (s) |      cpu (s) |      calls |   per gen (ms)\n";
+   for (int s = 0; s < NBSTAGE; ++s) {
+      os << " " << std::left << std::setw(13) << STAGE_NAME[s] << std::right << " | "
+         << std::setw(12) << std::fixed << std::setprecision(6) << t[s].wall << " | "
+         << std::setw(12) << t[s].cpu << " | "
+         << std::setw(10) << t[s].count << " | "
+         << std::setw(14) << std::setprecision(4) << (pergen.empty() ? 0.0 : 1e3 * t[s].wall / pergen.size()) << "\n";
+   }
+   // load balance of threads
+   os << "\n thread        |";
+   for (int s = 0; s < NBSTAGE; ++s) os << " " << std::setw(13) << STAGE_NAME[s] << " |";
+   os << "\n";
+   for (size_t i = 0; i < u.size(); ++i) {
+      os << " " << std::left << std::setw(13) << i << std::right << " |";
+      for (int s = 0; s < NBSTAGE; ++s) os << " " << std::setw(13) << std::setprecision(6) << u[i][s].wall << " |";
+      os << "\n";
+   }
+
+   // hardware counters, per call of stage (per evaluation for evaluate stage of non batch objective)
+   if (hwcounting) {
+      double cycles = 0.0;
+      for (int s = 0; s < NBSTAGE; ++s) cycles += t[s].hw[0];
+      if (cycles == 0.0) {
+         os << "\n hardware counters not available (perf_event_open failed, see kernel.perf_event_paranoid)\n";
+      } else {
+         os << "\n stage         |       cycles | instructions |    IPC | cache-misses | branch-misses |  cycles/call | c-miss/call | b-miss/call\n";
+         for (int s = 0; s < NBSTAGE; ++s) {
+            double n = t[s].count > 0 ? (double)t[s].count : 1.0;
+            os << " " << std::left << std::setw(13) << STAGE_NAME[s] << std::right << std::setprecision(0)
+               << " | " << std::setw(12) << t[s].hw[0]
+               << " | " << std::setw(12) << t[s].hw[1]
+               << " | " << std::setw(6) << std::setprecision(3) << (t[s].hw[0] > 0 ? t[s].hw[1] / t[s].hw[0] : 0.0) << std::setprecision(0)
+               << " | " << std::setw(12) << t[s].hw[2]
+               << " | " << std::setw(13) << t[s].hw[3]
+               << " | " << std::setw(12) << t[s].hw[0] / n
+               << " | " << std::setw(11) << std::setprecision(2) << t[s].hw[2] / n
+               << " | " << std::setw(11) << t[s].hw[3] / n << "\n";
+         }
+      }
+   }
+   os << "\n";
+}
+
+//=================================================================================================
+
+}
+
+#endif
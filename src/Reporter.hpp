@@ -0,0 +1,266 @@
+//=================================================================================================
+//                  Copyright (C) 2018 Alain Lanthier - All Rights Reserved
+//                  License: MIT License    See LICENSE.md for the full license.
+//                  Original code 2017 Olivier Mallet (MIT License)
+//=================================================================================================
+
+#ifndef REPORTER_HPP
+#define REPORTER_HPP
+
+namespace galgo {
+
+//=================================================================================================
+
+// lock-free queue for one producer thread and one consumer thread, slots are preallocated and
+// filled in place so that once warmed up nothing is allocated
+template <typename T>
+class SpscQueue
+{
+public:
+   explicit SpscQueue(size_t capacity) : slots(capacity + 1) {}
+
+   // producer: slot to fill at back of queue, nullptr if queue is full
+   T* back()
+   {
+      size_t t = tail.load(std::memory_order_relaxed);
+      if (next(t) == head.load(std::memory_order_acquire)) return nullptr;
+      return &slots[t];
+   }
+   // producer: publish slot returned by back()
+   void push()
+   {
+      tail.store(next(tail.load(std::memory_order_relaxed)), std::memory_order_release);
+   }
+
+   // consumer: slot at front of queue, nullptr if queue is empty
+   T* front()
+   {
+      size_t h = head.load(std::memory_order_relaxed);
+      if (h == tail.load(std::memory_order_acquire)) return nullptr;
+      return &slots[h];
+   }
+   // consumer: release slot returned by front()
+   void pop()
+   {
+      head.store(next(head.load(std::memory_order_relaxed)), std::memory_order_release);
+   }
+
+   bool empty() const
+   {
+      return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire);
+   }
+
+private:
+   std::vector<T> slots;
+   std::atomic<size_t> head{0};   // next slot to consume
+   char pad[64];                  // head and tail on different cache lines
+   std::atomic<size_t> tail{0};   // next slot to fill
+
+   size_t next(size_t i) const { return i + 1 == slots.size() ? 0 : i + 1; }
+};
+
+/*-------------------------------------------------------------------------------------------------*/
+
+// per generation snapshot sent to reporter
+struct GenerationReport
+{
+   int nogen = 0;                   // numero of generation
+   int nbgen = 0;                   // number of generations
+   double best = 0.0;               // best objective total
+   double mean = 0.0;               // mean objective total of feasible chromosomes
+   double stddev = 0.0;             // standard deviation of objective total of feasible chromosomes
+   int feasible = 0;                // number of feasible chromosomes (whole population without constraint)
+   double diversity = 0.0;          // mean pairwise Hamming distance between genomes / number of bits
+   double seconds = 0.0;            // wall time of this generation
+   double elapsed = 0.0;            // wall time since start of run
+   double memory = 0.0;             // bytes held by galgo components (see MemoryAccount)
+   double peakmemory = 0.0;         // peak bytes since start of run
+   std::vector<double> param;       // best chromosome parameter(s)
+   std::vector<double> result;      // best chromosome objective result(s)
+   std::vector<std::pair<const char*, double>> timings;  // optional named timings (seconds)
+};
+
+// output format of reporter
+enum class ReportFormat { Text, CSV, JSON };
+
+/*-------------------------------------------------------------------------------------------------*/
+
+// Asynchronous progress reporter (set ConfigInfo::reporter, owned by user): the GA thread only fills
+// a preallocated snapshot and pushes it on a lock-free queue, a background thread formats it.
+// Snapshots are dropped (and counted) rather than waited for when the queue is full.
+class Reporter
+{
+public:
+   Reporter(std::ostream& os = std::cout, ReportFormat format = ReportFormat::Text, int precision = 10, size_t capacity = 1024);
+   ~Reporter();
+
+   Reporter(const Reporter&) = delete;
+   Reporter& operator=(const Reporter&) = delete;
+
+   // producer: snapshot to fill, nullptr if queue is full (snapshot dropped)
+   GenerationReport* acquire();
+   // producer: send snapshot returned by acquire()
+   void publish();
+   // wait until every published snapshot has been written
+   void flush();
+
+   // number of dropped snapshots
+   uint64_t dropped() const { return nbdropped.load(); }
+
+private:
+   std::ostream& os;
+   ReportFormat format;
+   int precision;
+   SpscQueue<GenerationReport> queue;
+   std::atomic<bool> stopping{false};
+   std::atomic<uint64_t> nbdropped{0};
+   bool header = false;
+   std::ostringstream text;       // snapshot formatted by background thread, written at once to os
+   std::thread worker;
+
+   void consume();
+   void write(const GenerationReport& r);
+   void number(double x, bool json);
+};
+
+/*-------------------------------------------------------------------------------------------------*/
+
+// constructor, starting background thread
+inline Reporter::Reporter(std::ostream& os, ReportFormat format, int precision, size_t capacity)
+   : os(os), format(format), precision(precision), queue(capacity)
+{
+   worker = std::thread(&Reporter::consume, this);
+}
+
+// destructor, writing remaining snapshots
+inline Reporter::~Reporter()
+{
+   stopping = true;
+   worker.join();
+}
+
+/*-------------------------------------------------------------------------------------------------*/
+
+inline GenerationReport* Reporter::acquire()
+{
+   GenerationReport* r = queue.back();
+   if (r == nullptr) nbdropped++;
+   return r;
+}
+
+inline void Reporter::publish()
+{
+   queue.push();
+}
+
+inline void Reporter::flush()
+{
+   // a slot is released only once written
+   while (!queue.empty()) {
+      std::this_thread::sleep_for(std::chrono::microseconds(100));
+   }
+}
+
+/*-------------------------------------------------------------------------------------------------*/
+
+// background thread: formatting snapshots until stopped and queue is empty
+inline void Reporter::consume()
+{
+   for (;;) {
+      GenerationReport* r = queue.front();
+      if (r != nullptr) {
+         write(*r);
+         queue.pop();
+         continue;
+      }
+      os.flush();
+      if (stopping) break;
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+   }
+}
+
+/*-------------------------------------------------------------------------------------------------*/
+
+// write number, non finite values as null in JSON
+inline void Reporter::number(double x, bool json)
+{
+   if (json && !std::isfinite(x)) text << "null";
+   else text << x;
+}
+
+// format one snapshot into text (format flags of user stream untouched), then write it to os at once
+inline void Reporter::write(const GenerationReport& r)
+{
+   text.str(std::string());
+   std::ostream& os = text;
+   os << std::fixed << std::setprecision(precision);
+
+   if (format == ReportFormat::Text) {
+      os << " Generation = " << std::setw(std::to_string(r.nbgen).size()) << r.nogen << " |";
+      for (size_t i = 0; i < r.param.size(); ++i) {
+         os << " X" << (r.param.size() > 1 ? std::to_string(i + 1) : "") << " = " << r.param[i] << " |";
+      }
+      for (size_t i = 0; i < r.result.size(); ++i) {
+         os << " F" << (r.result.size() > 1 ? std::to_string(i + 1) : "") << "(x) = " << r.result[i] << " |";
+      }
+      os << " mean = " << r.mean << " | stddev = " << r.stddev << " | feasible = " << r.feasible << " | diversity = " << std::setprecision(4) << r.diversity;
+      os << " | time = " << r.seconds << " s";
+      os << " | memory = " << std::setprecision(1) << r.memory / 1048576.0 << " MB (peak " << r.peakmemory / 1048576.0 << " MB)" << std::setprecision(4);
+      for (const auto& t : r.timings) os << " | " << t.first << " = " << t.second << " s";
+      os << "\n";
+   }
+   else if (format == ReportFormat::CSV) {
+      if (!header) {
+         os << "generation,best,mean,stddev,feasible,diversity,seconds,elapsed,memory,peakmemory";
+         for (size_t i = 0; i < r.param.size(); ++i) os << ",x" << i + 1;
+         for (size_t i = 0; i < r.result.size(); ++i) os << ",f" << i + 1;
+         for (const auto& t : r.timings) os << "," << t.first;
+         os << "\n";
+         header = true;
+      }
+      os << r.nogen << "," << r.best << "," << r.mean << "," << r.stddev << "," << r.feasible << "," << r.diversity << "," << r.seconds << "," << r.elapsed;
+      os << "," << std::setprecision(0) << r.memory << "," << r.peakmemory << std::setprecision(precision);
+      for (double x : r.param) os << "," << x;
+      for (double x : r.result) os << "," << x;
+      for (const auto& t : r.timings) os << "," << t.second;
+      os << "\n";
+   }
+   else {
+      // one JSON object per line
+      os << "{\"generation\":" << r.nogen << ",\"best\":";
+      number(r.best, true);
+      os << ",\"mean\":";
+      number(r.mean, true);
+      os << ",\"stddev\":";
+      number(r.stddev, true);
+      os << ",\"feasible\":" << r.feasible << ",\"diversity\":" << r.diversity << ",\"seconds\":" << r.seconds << ",\"elapsed\":" << r.elapsed;
+      os << ",\"memory\":" << std::setprecision(0) << r.memory << ",\"peakmemory\":" << r.peakmemory << std::setprecision(precision) << ",\"x\":[";
+      for (size_t i = 0; i < r.param.size(); ++i) {
+         if (i) os << ",";
+         number(r.param[i], true);
+      }
+      os << "],\"f\":[";
+      for (size_t i = 0; i < r.result.size(); ++i) {
+         if (i) os << ",";
+         number(r.result[i], true);
+      }
+      os << "]";
+      if (!r.timings.empty()) {
+         os << ",\"timings\":{";
+         for (size_t i = 0; i < r.timings.size(); ++i) {
+            if (i) os << ",";
+            os << "\"" << r.timings[i].first << "\":" << r.timings[i].second;
+         }
+         os << "}";
+      }
+      os << "}\n";
+   }
+
+   this->os << text.str();
+}
+
+//=================================================================================================
+
+}
+
+#endif
@@ -0,0 +1,458 @@
+//=================================================================================================
+//                  Copyright (C) 2018 Alain Lanthier - All Rights Reserved
+//                  License: MIT License    See LICENSE.md for the full license.
+//                  Original code 2017 Olivier Mallet (MIT License)
+//=================================================================================================
+
+#ifndef SIMD_HPP
+#define SIMD_HPP
+
+// Vector kernels are compiled for several instruction sets and the best one supported by the
+// running CPU is selected at startup (GCC/Clang on x86), so that a single binary built for the
+// lowest target still runs at full speed on recent CPUs.
+// The variant can be forced with SetSimdLevel() or with environment variable GALGO_SIMD
+// (scalar, sse42, avx2, avx512), a forced level is lowered to what the CPU supports.
+// Without runtime dispatch (other compilers or CPUs) only variants enabled at compile time are built.
+
+#if defined(GALGO_SIMD_DISPATCH)
+#define GALGO_TARGET(isa) __attribute__((target(isa)))
+#define GALGO_SIMD_SSE42
+#define GALGO_SIMD_AVX2
+#define GALGO_SIMD_AVX512
+#else
+#define GALGO_TARGET(isa)
+#if defined(__SSE4_2__)
+#define GALGO_SIMD_SSE42
+#endif
+#if defined(__AVX2__) && defined(__FMA__)
+#define GALGO_SIMD_AVX2
+#endif
+#if defined(__AVX512F__) && defined(__AVX512BW__)
+#define GALGO_SIMD_AVX512
+#endif
+#endif
+
+namespace galgo {
+
+//=================================================================================================
+
+// instruction set of vector kernels
+enum class SimdLevel { Scalar = 0, SSE42 = 1, AVX2 = 2, AVX512 = 3 };
+
+/*-------------------------------------------------------------------------------------------------*/
+
+// packing remaining characters (from position i) of string of '0' and '1', see PackBits()
+inline void PackBitsTail(const char* s, int i, int n, uint64_t* words)
+{
+   for (; i < n; i += 64) {
+      int m = std::min(64, n - i);
+      uint64_t x = 0;
+      for (int j = 0; j < m; ++j) {
+         x = (x << 1) | (uint64_t)(s[i + j] == '1');
+      }
+      words[i >> 6] = m < 64 ? x << (64 - m) : x;
+   }
+   words[(n + 63) >> 6] = 0;
+}
+
+inline void PackBitsScalar(const std::string& chr, uint64_t* words)
+{
+   PackBitsTail(chr.data(), 0, (int)chr.size(), words);
+}
+
+#if defined(GALGO_SIMD_SSE42)
+// 16 characters per movemask, bytes reversed so that first character lands in bit 15
+GALGO_TARGET("sse4.2")
+inline void PackBitsSSE42(const std::string& chr, uint64_t* words)
+{
+   const int n = (int)chr.size();
+   const char* s = chr.data();
+   const __m128i one = _mm_set1_epi8('1');
+   const __m128i rev = _mm_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+   int i = 0;
+   for (; i + 64 <= n; i += 64) {
+      uint64_t x = 0;
+      for (int j = 0; j < 64; j += 16) {
+         __m128i v = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i + j)), rev);
+         x = (x << 16) | (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(v, one));
+      }
+      words[i >> 6] = x;
+   }
+   PackBitsTail(s, i, n, words);
+}
+#endif
+
+#if defined(GALGO_SIMD_AVX2)
+// 32 characters per movemask, bytes reversed so that first character lands in bit 31
+GALGO_TARGET("avx2")
+inline void PackBitsAVX2(const std::string& chr, uint64_t* words)
+{
+   const int n = (int)chr.size();
+   const char* s = chr.data();
+   const __m256i one = _mm256_set1_epi8('1');
+   const __m256i rev = _mm256_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0,
+                                        15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+   int i = 0;
+   for (; i + 64 <= n; i += 64) {
+      __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i));
+      __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i + 32));
+      hi = _mm256_permute4x64_epi64(_mm256_shuffle_epi8(hi, rev), 0x4E);
+      lo = _mm256_permute4x64_epi64(_mm256_shuffle_epi8(lo, rev), 0x4E);
+      uint64_t h = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(hi, one));
+      uint64_t l = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(lo, one));
+      words[i >> 6] = (h << 32) | l;
+   }
+   PackBitsTail(s, i, n, words);
+}
+#endif
+
+#if defined(GALGO_SIMD_AVX512)
+// 64 characters per compare mask, first character landing in bit 63
+GALGO_TARGET("avx512f,avx512bw")
+inline void PackBitsAVX512(const std::string& chr, uint64_t* words)
+{
+   const int n = (int)chr.size();
+   const char* s = chr.data();
+   const __m512i one = _mm512_set1_epi8('1');
+   const __m512i rev = _mm512_set_epi64(0x0001020304050607LL, 0x08090A0B0C0D0E0FLL, 0x0001020304050607LL, 0x08090A0B0C0D0E0FLL,
+                                        0x0001020304050607LL, 0x08090A0B0C0D0E0FLL, 0x0001020304050607LL, 0x08090A0B0C0D0E0FLL);
+   int i = 0;
+   for (; i + 64 <= n; i += 64) {
+      // bytes reversed inside each 16 bytes lane, lanes order is restored on the mask
+      __m512i v = _mm512_shuffle_epi8(_mm512_loadu_si512(s + i), rev);
+      uint64_t x = (uint64_t)_mm512_cmpeq_epi8_mask(v, one);
+      x = (x >> 32) | (x << 32);
+      x = ((x & 0xFFFF0000FFFF0000ULL) >> 16) | ((x & 0x0000FFFF0000FFFFULL) << 16);
+      words[i >> 6] = x;
+   }
+   PackBitsTail(s, i, n, words);
+}
+#endif
+
+/*-------------------------------------------------------------------------------------------------*/
+
+// y[i] = lower[i] + x[i] * scale[i]
+inline void ScaleBitsScalar(const double* x, const double* scale, const double* lower, double* y, int n)
+{
+   for (int i = 0; i < n; ++i) {
+      y[i] = lower[i] + x[i] * scale[i];
+   }
+}
+
+#if defined(GALGO_SIMD_SSE42)
+GALGO_TARGET("sse4.2")
+inline void ScaleBitsSSE42(const double* x, const double* scale, const double* lower, double* y, int n)
+{
+   int i = 0;
+   for (; i + 2 <= n; i += 2) {
+      __m128d v = _mm_add_pd(_mm_loadu_pd(lower + i), _mm_mul_pd(_mm_loadu_pd(x + i), _mm_loadu_pd(scale + i)));
+      _mm_storeu_pd(y + i, v);
+   }
+   ScaleBitsScalar(x + i, scale + i, lower + i, y + i, n - i);
+}
+#endif
+
+#if defined(GALGO_SIMD_AVX2)
+GALGO_TARGET("avx2,fma")
+inline void ScaleBitsAVX2(const double* x, const double* scale, const double* lower, double* y, int n)
+{
+   int i = 0;
+   for (; i + 4 <= n; i += 4) {
+      __m256d v = _mm256_fmadd_pd(_mm256_loadu_pd(x + i), _mm256_loadu_pd(scale + i), _mm256_loadu_pd(lower + i));
+      _mm256_storeu_pd(y + i, v);
+   }
+   ScaleBitsScalar(x + i, scale + i, lower + i, y + i, n - i);
+}
+#endif
+
+#if defined(GALGO_SIMD_AVX512)
+GALGO_TARGET("avx512f")
+inline void ScaleBitsAVX512(const double* x, const double* scale, const double* lower, double* y, int n)
+{
+   int i = 0;
+   for (; i + 8 <= n; i += 8) {
+      __m512d v = _mm512_fmadd_pd(_mm512_loadu_pd(x + i), _mm512_loadu_pd(scale + i), _mm512_loadu_pd(lower + i));
+      _mm512_storeu_pd(y + i, v);
+   }
+   ScaleBitsScalar(x + i, scale + i, lower + i, y + i, n - i);
+}
+#endif
+
+/*-------------------------------------------------------------------------------------------------*/
+
+// y[i] = sin(x[i]), y[i] = cos(x[i]), y[i] = exp(x[i]) (y may be x)
+inline void VecSinScalar(const double* x, double* y, int n)
+{
+   for (int i = 0; i < n; ++i) y[i] = std::sin(x[i]);
+}
+
+inline void VecCosScalar(const double* x, double* y, int n)
+{
+   for (int i = 0; i < n; ++i) y[i] = std::cos(x[i]);
+}
+
+inline void VecExpScalar(const double* x, double* y, int n)
+{
+   for (int i = 0; i < n; ++i) y[i] = std::exp(x[i]);
+}
+
+#if defined(GALGO_SIMD_AVX2)
+// sin(x + shift * pi/2): reduction to [-pi/4,pi/4] by 3 parts of pi/2 (Cody-Waite) and fdlibm
+// polynomials, within 1-2 ulp of std::sin/std::cos; lanes beyond 1e5 (or NaN) use std::sin
+GALGO_TARGET("avx2,fma")
+inline void VecSinCosAVX2(const double* x, double* y, int n, int shift)
+{
+   const __m256d absmask = _mm256_castsi256_pd(_mm256_set1_epi64x(0x7FFFFFFFFFFFFFFFLL));
+   const __m256d limit = _mm256_set1_pd(1e5);
+   const __m256d invpio2 = _mm256_set1_pd(6.36619772367581382433e-01);
+   const __m256d pio2_1 = _mm256_set1_pd(1.57079632673412561417e+00);
+   const __m256d pio2_2 = _mm256_set1_pd(6.07710050630396597660e-11);
+   const __m256d pio2_3 = _mm256_set1_pd(2.02226624871116645580e-21);
+   const __m256d one = _mm256_set1_pd(1.0);
+   const __m256d half = _mm256_set1_pd(0.5);
+   const __m256i ione = _mm256_set1_epi64x(1);
+   const __m256i itwo = _mm256_set1_epi64x(2);
+   const __m128i ishift = _mm_set1_epi32(shift);
+
+   int i = 0;
+   for (; i + 4 <= n; i += 4) {
+      __m256d v = _mm256_loadu_pd(x + i);
+      if (_mm256_movemask_pd(_mm256_cmp_pd(_mm256_and_pd(v, absmask), limit, _CMP_NLE_UQ))) {
+         if (shift) VecCosScalar(x + i, y + i, 4);
+         else VecSinScalar(x + i, y + i, 4);
+         continue;
+      }
+      __m256d q = _mm256_round_pd(_mm256_mul_pd(v, invpio2), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+      __m256d r = _mm256_fnmadd_pd(q, pio2_1, v);
+      r = _mm256_fnmadd_pd(q, pio2_2, r);
+      r = _mm256_fnmadd_pd(q, pio2_3, r);
+      __m256d z = _mm256_mul_pd(r, r);
+
+      // sin(r)
+      __m256d ps = _mm256_fmadd_pd(z, _mm256_set1_pd(1.58969099521155010221e-10), _mm256_set1_pd(-2.50507602534068634195e-08));
+      ps = _mm256_fmadd_pd(z, ps, _mm256_set1_pd(2.75573137070700676789e-06));
+      ps = _mm256_fmadd_pd(z, ps, _mm256_set1_pd(-1.98412698298579493134e-04));
+      ps = _mm256_fmadd_pd(z, ps, _mm256_set1_pd(8.33333333332248946124e-03));
+      ps = _mm256_fmadd_pd(z, ps, _mm256_set1_pd(-1.66666666666666324348e-01));
+      __m256d s = _mm256_fmadd_pd(_mm256_mul_pd(z, r), ps, r);
+
+      // cos(r)
+      __m256d pc = _mm256_fmadd_pd(z, _mm256_set1_pd(-1.13596475577881948265e-11), _mm256_set1_pd(2.08757232129817482790e-09));
+      pc = _mm256_fmadd_pd(z, pc, _mm256_set1_pd(-2.75573143513906633035e-07));
+      pc = _mm256_fmadd_pd(z, pc, _mm256_set1_pd(2.48015872894767294178e-05));
+      pc = _mm256_fmadd_pd(z, pc, _mm256_set1_pd(-1.38888888888741095749e-03));
+      pc = _mm256_fmadd_pd(z, pc, _mm256_set1_pd(4.16666666666666019037e-02));
+      __m256d hz = _mm256_mul_pd(half, z);
+      __m256d w = _mm256_sub_pd(one, hz);
+      __m256d c = _mm256_add_pd(w, _mm256_fmadd_pd(_mm256_mul_pd(z, z), pc, _mm256_sub_pd(_mm256_sub_pd(one, w), hz)));
+
+      // quadrant: odd ones take cos(r), 2 and 3 are negated
+      __m256i quad = _mm256_cvtepi32_epi64(_mm_add_epi32(_mm256_cvtpd_epi32(q), ishift));
+      __m256d odd = _mm256_castsi256_pd(_mm256_cmpeq_epi64(_mm256_and_si256(quad, ione), ione));
+      __m256d sign = _mm256_castsi256_pd(_mm256_slli_epi64(_mm256_and_si256(quad, itwo), 62));
+      _mm256_storeu_pd(y + i, _mm256_xor_pd(_mm256_blendv_pd(s, c, odd), sign));
+   }
+   if (shift) VecCosScalar(x + i, y + i, n - i);
+   else VecSinScalar(x + i, y + i, n - i);
+}
+
+GALGO_TARGET("avx2,fma")
+inline void VecSinAVX2(const double* x, double* y, int n)
+{
+   VecSinCosAVX2(x, y, n, 0);
+}
+
+GALGO_TARGET("avx2,fma")
+inline void VecCosAVX2(const double* x, double* y, int n)
+{
+   VecSinCosAVX2(x, y, n, 1);
+}
+
+// exp(x) = 2^k * exp(r) with |r| <= ln(2)/2 and a degree 13 Taylor polynomial, within 1-2 ulp
+// of std::exp; lanes outside [-708,708] (overflow, subnormal results or NaN) use std::exp
+GALGO_TARGET("avx2,fma")
+inline void VecExpAVX2(const double* x, double* y, int n)
+{
+   const __m256d absmask = _mm256_castsi256_pd(_mm256_set1_epi64x(0x7FFFFFFFFFFFFFFFLL));
+   const __m256d limit = _mm256_set1_pd(708.0);
+   const __m256d log2e = _mm256_set1_pd(1.44269504088896338700e+00);
+   const __m256d ln2hi = _mm256_set1_pd(6.93147180369123816490e-01);
+   const __m256d ln2lo = _mm256_set1_pd(1.90821492927058770002e-10);
+   const __m256i bias = _mm256_set1_epi64x(1023);
+
+   // 1/13!, 1/12!, ..., 1/2!, 1, 1
+   static const double coef[14] = {
+      1.0 / 6227020800.0, 1.0 / 479001600.0, 1.0 / 39916800.0, 1.0 / 3628800.0, 1.0 / 362880.0,
+      1.0 / 40320.0, 1.0 / 5040.0, 1.0 / 720.0, 1.0 / 120.0, 1.0 / 24.0, 1.0 / 6.0, 0.5, 1.0, 1.0
+   };
+
+   int i = 0;
+   for (; i + 4 <= n; i += 4) {
+      __m256d v = _mm256_loadu_pd(x + i);
+      if (_mm256_movemask_pd(_mm256_cmp_pd(_mm256_and_pd(v, absmask), limit, _CMP_NLE_UQ))) {
+         VecExpScalar(x + i, y + i, 4);
+         continue;
+      }
+      __m256d k = _mm256_round_pd(_mm256_mul_pd(v, log2e), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+      __m256d r = _mm256_fnmadd_pd(k, ln2hi, v);
+      r = _mm256_fnmadd_pd(k, ln2lo, r);
+
+      __m256d p = _mm256_set1_pd(coef[0]);
+      for (int j = 1; j < 14; ++j) {
+         p = _mm256_fmadd_pd(p, r, _mm256_set1_pd(coef[j]));
+      }
+
+      __m256i e = _mm256_slli_epi64(_mm256_add_epi64(_mm256_cvtepi32_epi64(_mm256_cvtpd_epi32(k)), bias), 52);
+      _mm256_storeu_pd(y + i, _mm256_mul_pd(p, _mm256_castsi256_pd(e)));
+   }
+   VecExpScalar(x + i, y + i, n - i);
+}
+#endif
+
+/*-------------------------------------------------------------------------------------------------*/
+
+// table of kernels for one instruction set
+struct SimdKernels
+{
+   SimdLevel level = SimdLevel::Scalar;
+   void(*packbits)(const std::string&, uint64_t*) = PackBitsScalar;
+   void(*scalebits)(const double*, const double*, const double*, double*, int) = ScaleBitsScalar;
+   void(*vecsin)(const double*, double*, int) = VecSinScalar;
+   void(*veccos)(const double*, double*, int) = VecCosScalar;
+   void(*vecexp)(const double*, double*, int) = VecExpScalar;
+};
+
+/*-------------------------------------------------------------------------------------------------*/
+
+// highest instruction set supported by running CPU (and built)
+inline SimdLevel DetectSimdLevel()
+{
+#if defined(GALGO_SIMD_DISPATCH)
+   __builtin_cpu_init();
+   if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw")) return SimdLevel::AVX512;
+   if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) return SimdLevel::AVX2;
+   if (__builtin_cpu_supports("sse4.2")) return SimdLevel::SSE42;
+   return SimdLevel::Scalar;
+#elif defined(GALGO_SIMD_AVX512)
+   return SimdLevel::AVX512;
+#elif defined(GALGO_SIMD_AVX2)
+   return SimdLevel::AVX2;
+#elif defined(GALGO_SIMD_SSE42)
+   return SimdLevel::SSE42;
+#else
+   return SimdLevel::Scalar;
+#endif
+}
+
+/*-------------------------------------------------------------------------------------------------*/
+
+// kernels of given instruction set, falling back to lower ones for missing variants
+inline SimdKernels MakeSimdKernels(SimdLevel level)
+{
+   level = std::min(level, DetectSimdLevel());
+
+   SimdKernels k;
+   k.level = level;
+#if defined(GALGO_SIMD_SSE42)
+   if (level >= SimdLevel::SSE42) {
+      k.packbits = PackBitsSSE42;
+      k.scalebits = ScaleBitsSSE42;
+   }
+#endif
+#if defined(GALGO_SIMD_AVX2)
+   if (level >= SimdLevel::AVX2) {
+      k.packbits = PackBitsAVX2;
+      k.scalebits = ScaleBitsAVX2;
+      k.vecsin = VecSinAVX2;
+      k.veccos = VecCosAVX2;
+      k.vecexp = VecExpAVX2;
+   }
+#endif
+#if defined(GALGO_SIMD_AVX512)
+   if (level >= SimdLevel::AVX512) {
+      k.packbits = PackBitsAVX512;
+      k.scalebits = ScaleBitsAVX512;
+   }
+#endif
+   return k;
+}
+
+/*-------------------------------------------------------------------------------------------------*/
+
+// instruction set requested by environment variable GALGO_SIMD (detected one otherwise)
+inline SimdLevel InitialSimdLevel()
+{
+   const char* env = std::getenv("GALGO_SIMD");
+   if (env != nullptr) {
+      std::string s(env);
+      if (s == "scalar") return SimdLevel::Scalar;
+      if (s == "sse42") return SimdLevel::SSE42;
+      if (s == "avx2") return SimdLevel::AVX2;
+      if (s == "avx512") return SimdLevel::AVX512;
+   }
+   return DetectSimdLevel();
+}
+
+// kernels in use, selected once at first call
+inline SimdKernels& Simd()
+{
+   static SimdKernels kernels = MakeSimdKernels(InitialSimdLevel());
+   return kernels;
+}
+
+// force instruction set of kernels (e.g. for benchmarking), must not be called while a GA runs
+// return instruction set actually used
+inline SimdLevel SetSimdLevel(SimdLevel level)
+{
+   Simd() = MakeSimdKernels(level);
+   return Simd().level;
+}
+
+inline const char* SimdLevelName(SimdLevel level)
+{
+   switch (level) {
+      case SimdLevel::SSE42: return "sse42";
+      case SimdLevel::AVX2: return "avx2";
+      case SimdLevel::AVX512: return "avx512";
+      default: return "scalar";
+   }
+}
+
+/*-------------------------------------------------------------------------------------------------*/
+
+// pack string of '0' and '1' into 64 bits words, first character into most significant bit
+// words must hold (size + 63) / 64 + 1 words, last word is padding for ExtractBits()
+inline void PackBits(const std::string& chr, uint64_t* words)
+{
+   Simd().packbits(chr, words);
+}
+
+// y[i] = lower[i] + x[i] * scale[i]
+inline void ScaleBits(const double* x, const double* scale, const double* lower, double* y, int n)
+{
+   Simd().scalebits(x, scale, lower, y, n);
+}
+
+// y[i] = sin(x[i]), y may be x
+inline void VecSin(const double* x, double* y, int n)
+{
+   Simd().vecsin(x, y, n);
+}
+
+// y[i] = cos(x[i]), y may be x
+inline void VecCos(const double* x, double* y, int n)
+{
+   Simd().veccos(x, y, n);
+}
+
+// y[i] = exp(x[i]), y may be x
+inline void VecExp(const double* x, double* y, int n)
+{
+   Simd().vecexp(x, y, n);
+}
+
+//=================================================================================================
+
+}
+
+#endif
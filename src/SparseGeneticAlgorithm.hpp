@@ -0,0 +1,362 @@
+//=================================================================================================
+//                  Copyright (C) 2018 Alain Lanthier - All Rights Reserved
+//                  License: MIT License    See LICENSE.md for the full license.
+//                  Original code 2017 Olivier Mallet (MIT License)
+//=================================================================================================
+
+#ifndef SPARSEGENETICALGORITHM_HPP
+#define SPARSEGENETICALGORITHM_HPP
+
+namespace galgo
+{
+    /*-------------------------------------------------------------------------------------------------*/
+    // Sparse bit-string chromosome: sorted indexes of the bits set among nbbit bits.
+    // Memory and operators work are proportional to the number of bits set, not to nbbit.
+    struct SparseChromosome
+    {
+        std::vector<int> bits;          // sorted indexes of bits set
+        std::vector<double> result;     // objective function(s) result
+        double fitness = 0.0;           // sum of objective function(s) result
+    };
+
+    /*-------------------------------------------------------------------------------------------------*/
+
+    // sorted random positions in [0,n), each position drawn independently with probability p
+    // (geometric gaps between positions: one random draw per position)
+    inline void SparseDraw(int n, double p, std::vector<int>& pos)
+    {
+        pos.clear();
+        if (p <= 0.0 || n <= 0) return;
+        if (p >= 1.0) {
+            pos.resize(n);
+            std::iota(pos.begin(), pos.end(), 0);
+            return;
+        }
+        std::geometric_distribution<int64_t> gap(p);
+        for (int64_t i = gap(rng); i < n; i += gap(rng) + 1) {
+            pos.push_back((int)i);
+        }
+    }
+
+    /*-------------------------------------------------------------------------------------------------*/
+
+    // single point mutation: each of the nbbit bits flipped with probability mutrate, the flipped
+    // positions are drawn directly and merged with the bits set (symmetric difference)
+    inline void SparseSPM(SparseChromosome& chr, int nbbit, double mutrate)
+    {
+        static thread_local std::vector<int> flip;
+        static thread_local std::vector<int> bits;
+
+        SparseDraw(nbbit, mutrate, flip);
+        if (flip.empty()) return;
+
+        bits.clear();
+        std::set_symmetric_difference(chr.bits.begin(), chr.bits.end(), flip.begin(), flip.end(), std::back_inserter(bits));
+        chr.bits.swap(bits);
+    }
+
+    /*-------------------------------------------------------------------------------------------------*/
+
+    // one-point cross-over: bits before a random cut point are taken from one parent, others from the other one
+    inline void SparseP1XO(const SparseChromosome& x, const SparseChromosome& y, SparseChromosome& chr1, SparseChromosome& chr2, int nbbit)
+    {
+        int cut = uniform<int>(0, nbbit);
+        auto xcut = std::lower_bound(x.bits.begin(), x.bits.end(), cut);
+        auto ycut = std::lower_bound(y.bits.begin(), y.bits.end(), cut);
+
+        chr1.bits.assign(x.bits.begin(), xcut);
+        chr1.bits.insert(chr1.bits.end(), ycut, y.bits.end());
+        chr2.bits.assign(y.bits.begin(), ycut);
+        chr2.bits.insert(chr2.bits.end(), xcut, x.bits.end());
+    }
+
+    /*-------------------------------------------------------------------------------------------------*/
+
+    // uniform cross-over: bits set in both parents are set in both offspring, a bit set in one
+    // parent only goes to either offspring with probability 0.5 (same as UXO bit by bit)
+    inline void SparseUXO(const SparseChromosome& x, const SparseChromosome& y, SparseChromosome& chr1, SparseChromosome& chr2, int)
+    {
+        chr1.bits.clear();
+        chr2.bits.clear();
+
+        auto i = x.bits.begin();
+        auto j = y.bits.begin();
+        while (i != x.bits.end() || j != y.bits.end()) {
+            if (j == y.bits.end() || (i != x.bits.end() && *i < *j)) {
+                (proba(rng) < 0.50 ? chr1 : chr2).bits.push_back(*i++);
+            } else if (i == x.bits.end() || *j < *i) {
+                (proba(rng) < 0.50 ? chr2 : chr1).bits.push_back(*j++);
+            } else {
+                chr1.bits.push_back(*i++);
+                chr2.bits.push_back(*j++);
+            }
+        }
+    }
+
+    /*-------------------------------------------------------------------------------------------------*/
+
+    // dense representation of sparse chromosome: string of nbbit '0'/'1' (as Chromosome<T>::getBits())
+    inline std::string SparseToBits(const SparseChromosome& chr, int nbbit)
+    {
+        std::string bits(nbbit, '0');
+        for (int i : chr.bits) {
+            if (i < 0 || i >= nbbit) {
+                throw std::out_of_range("Error: in galgo::SparseToBits(const SparseChromosome&, int), bit index exceeding chromosome size.");
+            }
+            bits[i] = '1';
+        }
+        return bits;
+    }
+
+    // sparse chromosome from dense string of '0'/'1' (as Chromosome<T>::getBits())
+    inline void SparseFromBits(const std::string& bits, SparseChromosome& chr)
+    {
+        chr.bits.clear();
+        for (size_t i = 0; i < bits.size(); ++i) {
+            if (bits[i] == '1') chr.bits.push_back((int)i);
+        }
+    }
+
+    /*-------------------------------------------------------------------------------------------------*/
+    // Genetic algorithm on sparse bit-string chromosomes (e.g. feature selection).
+    // Objective receives the sorted indexes of bits set (ConfigInfo<int>::Objective).
+    // Chromosomes are evolved with tournament selection, CrossOver (SparseUXO by default) and
+    // Mutation (SparseSPM by default) plus elitism.
+    class SparseGeneticAlgorithm
+    {
+    public:
+        // objective function pointer
+        std::vector<double>(*Objective)(const std::vector<int>&) = nullptr;
+
+        // cross-over method
+        void(*CrossOver)(const SparseChromosome&, const SparseChromosome&, SparseChromosome&, SparseChromosome&, int) = SparseUXO;
+
+        // mutation method
+        void(*Mutation)(SparseChromosome&, int, double) = SparseSPM;
+
+        double covrate = .50;   // cross-over rate
+        double mutrate = .05;   // mutation rate (probability of flipping each bit)
+        double density = .01;   // probability of each bit being set in initial chromosomes
+        double tolerance = 0.0; // terminal condition (inactive if equal to zero)
+
+        int elitpop = 1;        // elit population size
+        int tntsize = 10;       // tournament size
+        int genstep = 10;       // generation step for outputting results
+        int precision = 10;     // precision for outputting results
+        int nbbit;              // number of bits per chromosome
+        int nbgen;              // number of generations
+        int popsize;            // population size
+        bool output;            // control if results must be outputted
+
+        // constructor
+        SparseGeneticAlgorithm(const ConfigInfo<int>& config, int nbbit, double density);
+
+        // run genetic algorithm
+        void run();
+
+        // return best chromosome
+        const SparseChromosome& result() const { return curpop[0]; }
+
+        // print results for each new generation
+        void print(bool force = false) const;
+
+        int get_nogen() const { return nogen; }
+
+    private:
+        int nogen = 0;                                // numero of generation
+        std::vector<SparseChromosome> curpop;         // current population
+        std::vector<SparseChromosome> newpop;         // new population
+        std::string unsupported;                      // first unsupported setting of config (empty = none)
+
+        void evaluate(SparseChromosome& chr) const;
+        const SparseChromosome& select() const;
+        void check() const;
+    };
+
+    /*-------------------------------------------------------------------------------------------------*/
+
+    // constructor
+    inline SparseGeneticAlgorithm::SparseGeneticAlgorithm(const ConfigInfo<int>& config, int nbbit, double density)
+        : density(density), nbbit(nbbit)
+    {
+        Objective = config.Objective;
+        covrate = config.covrate;
+        mutrate = config.mutrate;
+        tolerance = config.tolerance;
+        elitpop = config.elitpop;
+        tntsize = config.tntsize;
+        genstep = config.genstep;
+        precision = config.precision;
+        nbgen = config.nbgen;
+        popsize = config.popsize;
+        output = config.output;
+
+        // settings of config this genetic algorithm does not implement (ConfigInfo defaults RWS,
+        // P1XO and MutationSPM stand for operators not set, CrossOver and Mutation are set directly)
+        if (config.Selection != RWS<int> && config.Selection != TNT<int>) unsupported = "selection method other than TNT";
+        else if (config.CrossOver != P1XO<int>) unsupported = "cross-over method of ConfigInfo (set CrossOver of galgo::SparseGeneticAlgorithm)";
+        else if (config.mutinfo._type != MutationType::MutationSPM) unsupported = "mutation method of ConfigInfo (set Mutation of galgo::SparseGeneticAlgorithm)";
+        else if (config.BatchObjective != nullptr || config.ObjectiveSpan != nullptr || config.ObjectiveBounded != nullptr) unsupported = "objective other than Objective";
+        else if (config.multiobjective) unsupported = "multi-objective ranking";
+        else if (config.Constraint != nullptr || config.Adaptation != nullptr || config.constraintfirst) unsupported = "constraint(s)";
+        else if (config.FixedValue != nullptr || config.StopCondition != nullptr) unsupported = "FixedValue and StopCondition";
+        else if (config.pipeline_ratio != 0.0) unsupported = "pipelining (pipeline_ratio)";
+        else if (!config.checkpoint.empty() || config.checkpointstep != 0 || config.resume) unsupported = "checkpoints";
+        else if (config.archive != nullptr || config.history != nullptr || config.reporter != nullptr || config.trace != nullptr) unsupported = "archive, history log, reporter and trace";
+        else if (config.memorycap != 0) unsupported = "memory cap (memorycap)";
+    }
+
+    /*-------------------------------------------------------------------------------------------------*/
+
+    // evaluate chromosome
+    inline void SparseGeneticAlgorithm::evaluate(SparseChromosome& chr) const
+    {
+        chr.result = Objective(chr.bits);
+        chr.fitness = std::accumulate(chr.result.begin(), chr.result.end(), 0.0);
+    }
+
+    /*-------------------------------------------------------------------------------------------------*/
+
+    // tournament selection in current population
+    inline const SparseChromosome& SparseGeneticAlgorithm::select() const
+    {
+        int best = uniform<int>(0, popsize);
+        for (int j = 1; j < tntsize; ++j) {
+            int idx = uniform<int>(0, popsize);
+            if (curpop[idx].fitness > curpop[best].fitness) best = idx;
+        }
+        return curpop[best];
+    }
+
+    /*-------------------------------------------------------------------------------------------------*/
+
+    // check inputs validity
+    inline void SparseGeneticAlgorithm::check() const
+    {
+        if (Objective == nullptr) {
+            throw std::invalid_argument("Error: in class galgo::SparseGeneticAlgorithm, objective function cannot be null, please adjust.");
+        }
+        if (nbbit <= 0) {
+            throw std::invalid_argument("Error: in class galgo::SparseGeneticAlgorithm, number of bits (nbbit) cannot be <= 0, please choose an integral value > 0.");
+        }
+        if (density < 0.0 || density > 1.0) {
+            throw std::invalid_argument("Error: in class galgo::SparseGeneticAlgorithm, initial density cannot be outside [0.0,1.0], please choose a real value within this interval.");
+        }
+        if (popsize < 2) {
+            throw std::invalid_argument("Error: in class galgo::SparseGeneticAlgorithm, population size (popsize) cannot be < 2, please adjust.");
+        }
+        if (elitpop > popsize || elitpop < 0) {
+            throw std::invalid_argument("Error: in class galgo::SparseGeneticAlgorithm, elit population (elitpop) cannot outside [0,popsize], please choose an integral value within this interval.");
+        }
+        if (covrate < 0.0 || covrate > 1.0) {
+            throw std::invalid_argument("Error: in class galgo::SparseGeneticAlgorithm, cross-over rate (covrate) cannot outside [0.0,1.0], please choose a real value within this interval.");
+        }
+        if (mutrate < 0.0 || mutrate > 1.0) {
+            throw std::invalid_argument("Error: in class galgo::SparseGeneticAlgorithm, mutation rate (mutrate) cannot outside [0.0,1.0], please choose a real value within this interval.");
+        }
+        if (genstep <= 0) {
+            throw std::invalid_argument("Error: in class galgo::SparseGeneticAlgorithm, generation step (genstep) cannot be <= 0, please choose an integral value > 0.");
+        }
+        if (!unsupported.empty()) {
+            throw std::invalid_argument("Error: in class galgo::SparseGeneticAlgorithm, " + unsupported + " not supported, please use galgo::GeneticAlgorithm<T> or adjust.");
+        }
+    }
+
+    /*-------------------------------------------------------------------------------------------------*/
+
+    // run genetic algorithm
+    inline void SparseGeneticAlgorithm::run()
+    {
+        check();
+
+        if (output) {
+            std::cout << "\n Running Sparse Genetic Algorithm...\n";
+            std::cout << " -----------------------------------\n";
+        }
+
+        curpop.resize(popsize);
+        newpop.resize(popsize);
+
+        // creating population
+        nogen = 0;
+        for (int i = 0; i < popsize; ++i) {
+            SparseDraw(nbbit, density, curpop[i].bits);
+        }
+        #ifdef _OPENMP
+        #pragma omp parallel for num_threads(MAX_THREADS)
+        #endif
+        for (int i = 0; i < popsize; ++i) {
+            evaluate(curpop[i]);
+        }
+        std::sort(curpop.begin(), curpop.end(), [](const SparseChromosome& chr1, const SparseChromosome& chr2)->bool{return chr1.fitness > chr2.fitness;});
+
+        double bestResult = curpop[0].fitness;
+        double prevBestResult = bestResult;
+
+        if (output) print();
+
+        SparseChromosome spare;
+
+        for (nogen = 1; nogen <= nbgen; ++nogen)
+        {
+            // elitism
+            std::copy(curpop.begin(), curpop.begin() + elitpop, newpop.begin());
+
+            // breeding rest of new population
+            for (int i = elitpop; i < popsize; i += 2)
+            {
+                SparseChromosome& chr1 = newpop[i];
+                SparseChromosome& chr2 = i + 1 < popsize ? newpop[i + 1] : spare;
+
+                if (proba(rng) < covrate) {
+                    CrossOver(select(), select(), chr1, chr2, nbbit);
+                } else {
+                    chr1.bits = select().bits;
+                    chr2.bits = select().bits;
+                }
+
+                Mutation(chr1, nbbit, mutrate);
+                Mutation(chr2, nbbit, mutrate);
+            }
+
+            #ifdef _OPENMP
+            #pragma omp parallel for num_threads(MAX_THREADS)
+            #endif
+            for (int i = elitpop; i < popsize; ++i) {
+                evaluate(newpop[i]);
+            }
+
+            curpop.swap(newpop);
+            std::sort(curpop.begin(), curpop.end(), [](const SparseChromosome& chr1, const SparseChromosome& chr2)->bool{return chr1.fitness > chr2.fitness;});
+
+            bestResult = curpop[0].fitness;
+
+            if (output) print();
+
+            if (tolerance != 0.0)
+            {
+                if (fabs(bestResult - prevBestResult) < fabs(tolerance))
+                {
+                    break;
+                }
+                prevBestResult = bestResult;
+            }
+        }
+    }
+
+    /*-------------------------------------------------------------------------------------------------*/
+
+    // print results for each new generation
+    inline void SparseGeneticAlgorithm::print(bool force) const
+    {
+        if ((nogen % genstep == 0) || force)
+        {
+            const SparseChromosome& best = curpop[0];
+            std::cout << " Generation = " << std::setw(std::to_string(nbgen).size()) << nogen << " |";
+            std::cout << " bits set = " << std::setw(std::to_string(nbbit).size()) << best.bits.size() << " |";
+            std::cout << " F(x) = " << std::setw(12) << std::fixed << std::setprecision(precision) << best.fitness << "\n";
+        }
+    }
+}
+
+#endif
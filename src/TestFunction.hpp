@@ -84,6 +84,26 @@ double pso_styb_tang(std::vector< T > particle)
     return (result / 2.);
 }
 
+//--------------------------
+// batch helpers (ConfigInfo::BatchObjective): x holds one row of nbparam parameters per chromosome,
+// batch objectives work column by column on all rows so that loops run over contiguous arrays
+//--------------------------
+// col[r] = x[r][k]
+template <typename T>
+void BatchColumn(const std::vector<T>& x, int nbparam, int k, std::vector<double>& col)
+{
+    size_t nrow = x.size() / nbparam;
+    col.resize(nrow);
+    for (size_t r = 0; r < nrow; r++) col[r] = (double)x[r * nbparam + k];
+}
+
+// result[r] = { v[r] }, keeping capacity of result vectors
+inline void BatchResult(const std::vector<double>& v, std::vector<std::vector<double>>& result)
+{
+    result.resize(v.size());
+    for (size_t r = 0; r < v.size(); r++) result[r].assign(1, v[r]);
+}
+
 //--------------------------
 // Objectives
 //--------------------------
@@ -99,6 +119,34 @@ public:
         double obj = -pso_rastrigin<double>(xd);
         return { obj };
     }
+
+    // allocation free version (ConfigInfo::ObjectiveSpan)
+    static void ObjectiveSpan(galgo::Span<const T> x, galgo::Span<double> result, void*, galgo::ScratchArena&)
+    {
+        double sum = 10. * (double)x.size();
+        for (size_t i = 0; i < x.size(); i++) {
+            double d = (double)x[i];
+            sum += d * d - (10. * cos(2. * 3.14159 * d));
+        }
+        result[0] = -sum;
+    }
+
+    // batch version (ConfigInfo::BatchObjective)
+    static void BatchObjective(const std::vector<T>& x, int nbparam, std::vector<std::vector<double>>& result)
+    {
+        static thread_local std::vector<double> col, c, sum;
+        size_t nrow = x.size() / nbparam;
+        sum.assign(nrow, 10. * nbparam);
+        c.resize(nrow);
+        for (int k = 0; k < nbparam; k++) {
+            BatchColumn(x, nbparam, k, col);
+            for (size_t r = 0; r < nrow; r++) c[r] = 2. * 3.14159 * col[r];
+            galgo::VecCos(c.data(), c.data(), (int)nrow);
+            for (size_t r = 0; r < nrow; r++) sum[r] += col[r] * col[r] - (10. * c[r]);
+        }
+        for (size_t r = 0; r < nrow; r++) sum[r] = -sum[r];
+        BatchResult(sum, result);
+    }
 };
 
 template <typename T>
@@ -113,6 +161,40 @@ public:
         double obj = -pso_griewank<double>(xd);
         return { obj };
     }
+
+    // allocation free version (ConfigInfo::ObjectiveSpan)
+    static void ObjectiveSpan(galgo::Span<const T> x, galgo::Span<double> result, void*, galgo::ScratchArena&)
+    {
+        double sum(0.), product(1.);
+        for (size_t i = 0; i < x.size(); i++) {
+            double d = (double)x[i];
+            sum += d * d;
+            product *= cos(d / sqrt((double)i + 1));
+        }
+        result[0] = -(1. + (sum / 4000.) - product);
+    }
+
+    // batch version (ConfigInfo::BatchObjective)
+    static void BatchObjective(const std::vector<T>& x, int nbparam, std::vector<std::vector<double>>& result)
+    {
+        static thread_local std::vector<double> col, c, sum, product;
+        size_t nrow = x.size() / nbparam;
+        sum.assign(nrow, 0.);
+        product.assign(nrow, 1.);
+        c.resize(nrow);
+        for (int k = 0; k < nbparam; k++) {
+            BatchColumn(x, nbparam, k, col);
+            double d = sqrt((double)k + 1);
+            for (size_t r = 0; r < nrow; r++) c[r] = col[r] / d;
+            galgo::VecCos(c.data(), c.data(), (int)nrow);
+            for (size_t r = 0; r < nrow; r++) {
+                sum[r] += col[r] * col[r];
+                product[r] *= c[r];
+            }
+        }
+        for (size_t r = 0; r < nrow; r++) sum[r] = -(1. + (sum[r] / 4000.) - product[r]);
+        BatchResult(sum, result);
+    }
 };
 
 template <typename T>
@@ -127,6 +209,35 @@ public:
         double obj = -pso_styb_tang<double>(xd);
         return { obj };
     }
+
+    // allocation free version (ConfigInfo::ObjectiveSpan)
+    static void ObjectiveSpan(galgo::Span<const T> x, galgo::Span<double> result, void*, galgo::ScratchArena&)
+    {
+        double sum(0.);
+        for (size_t i = 0; i < x.size(); i++) {
+            double d = (double)x[i];
+            double d2 = d * d;
+            sum += d2 * d2 - (16. * d2) + (5. * d);
+        }
+        result[0] = -(sum / 2.);
+    }
+
+    // batch version (ConfigInfo::BatchObjective)
+    static void BatchObjective(const std::vector<T>& x, int nbparam, std::vector<std::vector<double>>& result)
+    {
+        static thread_local std::vector<double> col, sum;
+        size_t nrow = x.size() / nbparam;
+        sum.assign(nrow, 0.);
+        for (int k = 0; k < nbparam; k++) {
+            BatchColumn(x, nbparam, k, col);
+            for (size_t r = 0; r < nrow; r++) {
+                double d2 = col[r] * col[r];
+                sum[r] += d2 * d2 - (16. * d2) + (5. * col[r]);
+            }
+        }
+        for (size_t r = 0; r < nrow; r++) sum[r] = -(sum[r] / 2.);
+        BatchResult(sum, result);
+    }
 };
 
 template <typename T>
@@ -143,6 +254,22 @@ public:
         return { obj };
     }
     // NB: GALGO maximize by default so we will maximize -f(x,y)
+
+    // batch version (ConfigInfo::BatchObjective)
+    static void BatchObjective(const std::vector<T>& x, int nbparam, std::vector<std::vector<double>>& result)
+    {
+        static thread_local std::vector<double> x0, x1, obj;
+        size_t nrow = x.size() / nbparam;
+        BatchColumn(x, nbparam, 0, x0);
+        BatchColumn(x, nbparam, 1, x1);
+        obj.resize(nrow);
+        for (size_t r = 0; r < nrow; r++) {
+            double a = 1.0 - x0[r];
+            double b = x1[r] - x0[r] * x0[r];
+            obj[r] = -(a * a + 100 * b * b);
+        }
+        BatchResult(obj, result);
+    }
 };
 
 template <typename T>
@@ -156,6 +283,32 @@ public:
         double obj = -Ackley<double>(x0, x1);
         return { obj };
     }
+
+    // batch version (ConfigInfo::BatchObjective)
+    static void BatchObjective(const std::vector<T>& x, int nbparam, std::vector<std::vector<double>>& result)
+    {
+        const double pi = 3.14159265358979323846;
+        static thread_local std::vector<double> x0, x1, c0, c1, e0, e1;
+        size_t nrow = x.size() / nbparam;
+        BatchColumn(x, nbparam, 0, x0);
+        BatchColumn(x, nbparam, 1, x1);
+        c0.resize(nrow);
+        c1.resize(nrow);
+        e0.resize(nrow);
+        e1.resize(nrow);
+        for (size_t r = 0; r < nrow; r++) {
+            c0[r] = 2 * pi * x0[r];
+            c1[r] = 2 * pi * x1[r];
+            e0[r] = -0.2 * std::sqrt(0.5 * (x0[r] * x0[r] + x1[r] * x1[r]));
+        }
+        galgo::VecCos(c0.data(), c0.data(), (int)nrow);
+        galgo::VecCos(c1.data(), c1.data(), (int)nrow);
+        for (size_t r = 0; r < nrow; r++) e1[r] = 0.5 * (c0[r] + c1[r]);
+        galgo::VecExp(e0.data(), e0.data(), (int)nrow);
+        galgo::VecExp(e1.data(), e1.data(), (int)nrow);
+        for (size_t r = 0; r < nrow; r++) e0[r] = -(-20 * e0[r] - e1[r] + std::exp(1) + 20);
+        BatchResult(e0, result);
+    }
 };
 
 template <typename T>
@@ -0,0 +1,190 @@
+//=================================================================================================
+//                  Copyright (C) 2018 Alain Lanthier - All Rights Reserved
+//                  License: MIT License    See LICENSE.md for the full license.
+//                  Original code 2017 Olivier Mallet (MIT License)
+//=================================================================================================
+
+#ifndef TRACE_HPP
+#define TRACE_HPP
+
+namespace galgo {
+
+//=================================================================================================
+
+// one timed event of a thread
+struct TraceEvent
+{
+   const char* name = nullptr;   // static string
+   int generation = 0;
+   int64_t start = 0;            // wall clock (nanoseconds)
+   int64_t end = 0;
+};
+
+/*-------------------------------------------------------------------------------------------------*/
+
+// Trace of GA execution in Chrome trace-event format (JSON array of complete events, one track per
+// thread), viewable in chrome://tracing or Perfetto (set ConfigInfo::trace, owned by user).
+// Each thread records into its own ring buffer, drained into the file by flush() (end of run,
+// checkpoints, and by the recording thread itself when its ring buffer is full); events that still
+// cannot be recorded are dropped, counted and reported in the file as counter "dropped events".
+class TraceLog
+{
+public:
+   // create (or truncate) trace file, capacity is number of events of each ring buffer
+   TraceLog(const std::string& path, size_t capacity = 16384);
+   ~TraceLog();
+
+   TraceLog(const TraceLog&) = delete;
+   TraceLog& operator=(const TraceLog&) = delete;
+
+   // record event [start,end] into ring buffer of calling thread (thread safe)
+   void complete(const char* name, int generation, int64_t start, int64_t end);
+   // write events recorded so far (thread safe)
+   void flush();
+
+   // number of dropped events
+   uint64_t dropped() const { return nbdropped.load(); }
+
+private:
+   struct Ring
+   {
+      int tid;
+      SpscQueue<TraceEvent> events;
+      bool named = false;      // thread name written
+      Ring(int tid, size_t capacity) : tid(tid), events(capacity) {}
+   };
+
+   size_t capacity;
+   int64_t origin;                           // wall clock at creation, events are relative to it
+   FILE* file = nullptr;
+   bool first = true;                        // no event written yet
+   std::atomic<uint64_t> nbdropped{0};
+   uint64_t nbreported = 0;                  // dropped events already reported in file
+   std::mutex mtx;                           // protects file
+   PerThread<Ring> rings;
+
+   Ring& ring();
+   void write(const char* json);
+};
+
+/*-------------------------------------------------------------------------------------------------*/
+
+// scope event: recorded when closed or destroyed, nothing done without trace
+class TraceScope
+{
+public:
+   TraceScope(TraceLog* trace, const char* name, int generation) : trace(trace), name(name), generation(generation), start(trace != nullptr ? WallTime() : 0) {}
+   ~TraceScope() { close(); }
+
+   TraceScope(const TraceScope&) = delete;
+   TraceScope& operator=(const TraceScope&) = delete;
+
+   // record event now
+   void close()
+   {
+      if (trace == nullptr) return;
+      trace->complete(name, generation, start, WallTime());
+      trace = nullptr;
+   }
+
+private:
+   TraceLog* trace;
+   const char* name;
+   int generation;
+   int64_t start;
+};
+
+/*-------------------------------------------------------------------------------------------------*/
+
+// constructor
+inline TraceLog::TraceLog(const std::string& path, size_t capacity)
+   : capacity(capacity), origin(WallTime())
+{
+   if (capacity == 0) {
+      throw std::invalid_argument("Error: in class galgo::TraceLog, ring buffer capacity must be > 0, please adjust.");
+   }
+   file = std::fopen(path.c_str(), "w");
+   if (file == nullptr || std::fputs("[", file) == EOF) {
+      if (file != nullptr) std::fclose(file);
+      throw std::invalid_argument("Error: in class galgo::TraceLog, cannot create trace file " + path + ", please check path.");
+   }
+}
+
+// destructor, writing pending events and closing JSON array
+inline TraceLog::~TraceLog()
+{
+   flush();
+   std::fputs("\n]\n", file);
+   std::fclose(file);
+}
+
+/*-------------------------------------------------------------------------------------------------*/
+
+// ring buffer of calling thread, tracks numbered from 1 in order of first use
+inline TraceLog::Ring& TraceLog::ring()
+{
+   return rings.local([this](size_t i) { return std::unique_ptr<Ring>(new Ring((int)i + 1, capacity)); });
+}
+
+inline void TraceLog::complete(const char* name, int generation, int64_t start, int64_t end)
+{
+   SpscQueue<TraceEvent>& events = ring().events;
+   TraceEvent* e = events.back();
+   if (e == nullptr) {
+      // ring buffer full: draining it into file now
+      flush();
+      e = events.back();
+   }
+   if (e == nullptr) {
+      nbdropped++;
+      return;
+   }
+   e->name = name;
+   e->generation = generation;
+   e->start = start;
+   e->end = end;
+   events.push();
+}
+
+/*-------------------------------------------------------------------------------------------------*/
+
+inline void TraceLog::write(const char* json)
+{
+   std::fputs(first ? "\n" : ",\n", file);
+   std::fputs(json, file);
+   first = false;
+}
+
+// drain every ring buffer into file, timestamps in microseconds
+inline void TraceLog::flush()
+{
+   std::lock_guard<std::mutex> lock(mtx);
+   char json[256];
+   rings.each([this, &json](Ring& r) {
+      if (!r.named) {
+         std::snprintf(json, sizeof(json), "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"thread %d\"}}", r.tid, r.tid);
+         write(json);
+         r.named = true;
+      }
+      for (TraceEvent* e = r.events.front(); e != nullptr; e = r.events.front()) {
+         std::snprintf(json, sizeof(json), "{\"name\":\"%s\",\"cat\":\"galgo\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"generation\":%d}}",
+            e->name, r.tid, (e->start - origin) * 1e-3, (e->end - e->start) * 1e-3, e->generation);
+         write(json);
+         r.events.pop();
+      }
+   });
+   uint64_t dropped = nbdropped.load();
+   if (dropped != nbreported) {
+      std::snprintf(json, sizeof(json), "{\"name\":\"dropped events\",\"cat\":\"galgo\",\"ph\":\"C\",\"pid\":1,\"tid\":0,\"ts\":%.3f,\"args\":{\"dropped\":%llu}}",
+         (WallTime() - origin) * 1e-3, (unsigned long long)dropped);
+      write(json);
+      nbreported = dropped;
+   }
+   std::fflush(file);
+}
+
+//=================================================================================================
+
+}
+
+#endif
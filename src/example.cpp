@@ -11,11 +11,29 @@
 // Uncomment #define TEST_BINAIRO to test GA for Binairos
 // Uncomment #define TEST_CLASSIC_FUNCTIONS to test GA for classics functions
 // Uncomment #define TEST_INIT_POP to test by initializing initial population
+// Uncomment #define TEST_FIXED_GA to test fixed size GA (galgo::FixedGeneticAlgorithm)
+// Uncomment #define TEST_POLICY_GA to test policy based GA (galgo::GeneticAlgorithm<T, Policies...>)
+// Uncomment #define TEST_SPARSE_GA to test sparse GA (galgo::SparseGeneticAlgorithm)
+// Uncomment #define TEST_CHECKPOINT to test checkpoint resume (galgo::ConfigInfo::checkpoint)
+// Uncomment #define TEST_HISTORY to test history log round-trip (galgo::HistoryLog, galgo::HistoryReader)
+// Uncomment #define TEST_CELLULAR_GA to test cellular GA (galgo::CellularGeneticAlgorithm)
+// Uncomment #define TEST_PARETO_ARCHIVE to test Pareto archive (galgo::ParetoArchive)
+// Uncomment #define TEST_BITSLICED_POPULATION to test bit-sliced population round-trip (galgo::BitSlicedPopulation)
+// Uncomment #define TEST_REPORTER_TRACE to test JSON reporter and trace log (galgo::Reporter, galgo::TraceLog)
 //------------------------------------------------------------------------------
 //#define TEST_ALL_TYPE
 //#define TEST_BINAIRO
 //#define TEST_CLASSIC_FUNCTIONS
 #define TEST_INIT_POP
+#define TEST_FIXED_GA
+#define TEST_POLICY_GA
+#define TEST_SPARSE_GA
+#define TEST_CHECKPOINT
+#define TEST_HISTORY
+#define TEST_CELLULAR_GA
+#define TEST_PARETO_ARCHIVE
+#define TEST_BITSLICED_POPULATION
+#define TEST_REPORTER_TRACE
 
 #ifdef TEST_CLASSIC_FUNCTIONS
 #include "../test/Classic/Functions.hpp"
@@ -23,6 +41,33 @@
 #ifdef TEST_INIT_POP
 #include "../test/Classic/Functions.hpp"
 #endif
+#ifdef TEST_FIXED_GA
+#include "../test/Classic/Functions.hpp"
+#endif
+#ifdef TEST_POLICY_GA
+#include "../test/Classic/Functions.hpp"
+#endif
+#ifdef TEST_SPARSE_GA
+#include "../test/Classic/Functions.hpp"
+#endif
+#ifdef TEST_CHECKPOINT
+#include "../test/Classic/Functions.hpp"
+#endif
+#ifdef TEST_HISTORY
+#include "../test/Classic/Functions.hpp"
+#endif
+#ifdef TEST_CELLULAR_GA
+#include "../test/Classic/Functions.hpp"
+#endif
+#ifdef TEST_PARETO_ARCHIVE
+#include "../test/Classic/Functions.hpp"
+#endif
+#ifdef TEST_BITSLICED_POPULATION
+#include "../test/Classic/Functions.hpp"
+#endif
+#ifdef TEST_REPORTER_TRACE
+#include "../test/Classic/Functions.hpp"
+#endif
 
 #ifdef TEST_ALL_TYPE
 #include "../test/Types/TestTypes.hpp"
@@ -72,6 +117,42 @@ int main()
     }
 #endif
 
+#ifdef TEST_FIXED_GA
+    test_fixed_ga();
+#endif
+
+#ifdef TEST_POLICY_GA
+    test_policy_ga();
+#endif
+
+#ifdef TEST_SPARSE_GA
+    test_sparse_ga();
+#endif
+
+#ifdef TEST_CHECKPOINT
+    test_checkpoint();
+#endif
+
+#ifdef TEST_HISTORY
+    test_history();
+#endif
+
+#ifdef TEST_CELLULAR_GA
+    test_cellular_ga();
+#endif
+
+#ifdef TEST_PARETO_ARCHIVE
+    test_pareto_archive();
+#endif
+
+#ifdef TEST_BITSLICED_POPULATION
+    test_bitsliced_population();
+#endif
+
+#ifdef TEST_REPORTER_TRACE
+    test_reporter_trace();
+#endif
+
 #ifdef _WIN32
 	system("pause");
 #endif
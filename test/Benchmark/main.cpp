@@ -0,0 +1,535 @@
+//=================================================================================================
+//                  Copyright (C) 2018 Alain Lanthier - All Rights Reserved
+//                  License: MIT License    See LICENSE.md for the full license.
+//                  Original code 2017 Olivier Mallet (MIT License)
+//=================================================================================================
+
+//------------------------------------------------------------------------------
+// galgo_bench: fixed-seed single threaded throughput benchmarks (galgo::rng is shared by threads,
+// so only single threaded runs are reproducible), results written as JSON on standard output
+//    operator/...  every selection, cross-over and mutation method of Evolution.hpp
+//    run/...       GeneticAlgorithmN::run() on classic functions across population size,
+//                  number of parameters and number of bits, and across objective kinds (suffix /batch, /span, /bounded, /constraintfirst:
+//                  ConfigInfo::BatchObjective, ObjectiveSpan, ObjectiveBounded, Constraint evaluated
+//                  first), none for ConfigInfo::Objective
+//
+// usage: galgo_bench [--quick] [--filter text] [--repeat n] [--seed n] [--out file]
+//                    [--baseline file [--tolerance x] [--alloc-tolerance x]]
+//
+// With --baseline, allocations/generation of run benchmarks are compared with those of a previous
+// output (e.g. test/Benchmark/baseline.json, written with --out): a table of deltas is printed and
+// exit code is 1 if allocations/generation grew by more than alloc-tolerance (fraction, default 0.05).
+// Generations/sec depend on machine and build type and are only reported, unless --tolerance is
+// given: exit code is then also 1 if generations/sec dropped by tolerance or more (fraction, e.g.
+// 0.5 fails a benchmark running at half the baseline speed or slower).
+//------------------------------------------------------------------------------
+
+#include "Galgo.hpp"
+#include "../Classic/Functions.hpp"
+
+#include <fstream>
+
+using TYPE = double;
+
+//------------------------------------------------------------------------------
+// counting every heap allocation of the process
+//------------------------------------------------------------------------------
+std::atomic<uint64_t> BenchAllocations(0);
+
+// allocation by malloc and release by free are paired on purpose
+#if defined(__GNUC__) && __GNUC__ >= 11
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void* operator new(std::size_t size)
+{
+    BenchAllocations.fetch_add(1, std::memory_order_relaxed);
+    void* p = std::malloc(size > 0 ? size : 1);
+    if (p == nullptr) throw std::bad_alloc();
+    return p;
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+struct BenchOptions
+{
+    bool quick = false;         // fewer iterations and generations
+    std::string filter;         // only benchmarks whose name contains filter
+    int repeat = 3;             // timings kept are best of repeat runs
+    uint64_t seed = 20180901;   // seed of galgo::rng before each run
+    std::string out;            // JSON results file (empty = standard output)
+    std::string baseline;       // JSON results to compare with (empty = no comparison)
+    bool throughput = false;    // generations/sec checked against baseline (set by --tolerance)
+    double tolerance = 0.5;     // failing drop of generations/sec (fraction of baseline)
+    double alloctolerance = 0.05; // allowed growth of allocations/generation (fraction of baseline)
+};
+
+// throughput of one run benchmark, compared with baseline
+struct BenchResult
+{
+    std::string name;
+    double gps = 0.0;           // generations/sec
+    double apg = 0.0;           // allocations/generation
+};
+
+//------------------------------------------------------------------------------
+// one JSON object per benchmark and per line
+//------------------------------------------------------------------------------
+class BenchOutput
+{
+public:
+    BenchOutput(std::ostream& os, const BenchOptions& opt) : os(os)
+    {
+        os << "{\"galgo_bench\":{\"seed\":" << opt.seed << ",\"repeat\":" << opt.repeat << ",\"quick\":" << (opt.quick ? "true" : "false")
+           << "},\n\"benchmarks\":[";
+    }
+    ~BenchOutput() { os << "\n]}\n"; }
+
+    void row(const std::string& json)
+    {
+        os << (first ? "\n" : ",\n") << json;
+        os.flush();
+        first = false;
+    }
+
+    std::vector<BenchResult> results;   // run benchmarks
+
+private:
+    std::ostream& os;
+    bool first = true;
+};
+
+// format JSON number
+inline std::string BenchNumber(double x)
+{
+    char buf[64];
+    std::snprintf(buf, sizeof(buf), "%.6g", std::isfinite(x) ? x : 0.0);
+    return buf;
+}
+
+//------------------------------------------------------------------------------
+// objective counting its evaluations (each kind of objective of ConfigInfo)
+//------------------------------------------------------------------------------
+template <typename O>
+struct Counted
+{
+    static std::atomic<uint64_t> count;
+
+    static std::vector<double> Objective(const std::vector<TYPE>& x)
+    {
+        count.fetch_add(1, std::memory_order_relaxed);
+        return O::Objective(x);
+    }
+
+    static void BatchObjective(const std::vector<TYPE>& x, int nbparam, std::vector<std::vector<double>>& result)
+    {
+        count.fetch_add(x.size() / nbparam, std::memory_order_relaxed);
+        O::BatchObjective(x, nbparam, result);
+    }
+
+    static void ObjectiveSpan(galgo::Span<const TYPE> x, galgo::Span<double> result, void* context, galgo::ScratchArena& scratch)
+    {
+        count.fetch_add(1, std::memory_order_relaxed);
+        O::ObjectiveSpan(x, result, context, scratch);
+    }
+
+    static std::vector<double> ObjectiveBounded(const std::vector<TYPE>& x, double bound, bool& pruned)
+    {
+        count.fetch_add(1, std::memory_order_relaxed);
+        return O::ObjectiveBounded(x, bound, pruned);
+    }
+};
+
+// objective kinds of run benchmarks (config given classic settings)
+template <typename O>
+void BenchScalar(galgo::ConfigInfo<TYPE>& config) { config.Objective = Counted<O>::Objective; }
+
+template <typename O>
+void BenchBatch(galgo::ConfigInfo<TYPE>& config) { config.BatchObjective = Counted<O>::BatchObjective; }
+
+template <typename O>
+void BenchSpan(galgo::ConfigInfo<TYPE>& config) { config.ObjectiveSpan = Counted<O>::ObjectiveSpan; }
+
+template <typename O>
+void BenchBounded(galgo::ConfigInfo<TYPE>& config) { config.ObjectiveBounded = Counted<O>::ObjectiveBounded; }
+
+// constraint x0 <= 2, x1 <= 2 evaluated first, objective of feasible chromosomes only
+template <typename O>
+void BenchConstraintFirst(galgo::ConfigInfo<TYPE>& config)
+{
+    config.Objective = Counted<O>::Objective;
+    config.Constraint = MyConstraint<TYPE>;
+    config.constraintfirst = true;
+}
+
+template <typename O>
+std::atomic<uint64_t> Counted<O>::count(0);
+
+//------------------------------------------------------------------------------
+// GA of nbparam parameters (not run) and a population built from it: current population created,
+// evaluated and ranked, mating population selected by SUS
+//------------------------------------------------------------------------------
+template <int NBIT>
+struct BenchSetup
+{
+    galgo::ConfigInfo<TYPE> config;
+    std::vector<TYPE> lower, upper, initial;
+    std::unique_ptr<galgo::GeneticAlgorithmN<TYPE, NBIT>> ga;
+    std::unique_ptr<galgo::Population<TYPE>> population;
+
+    BenchSetup(const BenchOptions& opt, int popsize, int nbparam, bool multiobjective)
+        : lower(nbparam, (TYPE)-5.12), upper(nbparam, (TYPE)5.12)
+    {
+        set_classic_config<TYPE>(config);
+        config.output = false;
+        config.popsize = popsize;
+        config.multiobjective = multiobjective;
+        config.Objective = rastriginObjective<TYPE>::Objective;
+
+        galgo::rng.seed(opt.seed);
+        ga.reset(new galgo::GeneticAlgorithmN<TYPE, NBIT>(config, lower, upper, initial));
+        population.reset(new galgo::Population<TYPE>(*ga));
+        population->creation();
+        population->selecting(SUS<TYPE>);
+    }
+
+    galgo::Population<TYPE>& pop() { return *population; }
+};
+
+// best time (seconds) of opt.repeat runs of n calls of f, allocations of one run
+template <typename F>
+double BenchTime(const BenchOptions& opt, int n, F f, uint64_t& allocations)
+{
+    double best = std::numeric_limits<double>::max();
+    for (int r = 0; r < opt.repeat; ++r) {
+        galgo::rng.seed(opt.seed);
+        uint64_t first = BenchAllocations;
+        int64_t start = galgo::WallTime();
+        for (int i = 0; i < n; ++i) f();
+        best = std::min(best, (galgo::WallTime() - start) * 1e-9);
+        allocations = BenchAllocations - first;
+    }
+    return best;
+}
+
+//------------------------------------------------------------------------------
+// operator benchmarks (popsize 200, 8 parameters of 32 bits)
+//------------------------------------------------------------------------------
+const int OP_POPSIZE = 200;
+const int OP_NBPARAM = 8;
+const int OP_NBIT = 32;
+
+inline void OperatorRow(BenchOutput& out, const std::string& name, const char* kind, int calls, double seconds, uint64_t allocations)
+{
+    out.row("{\"name\":\"" + name + "\",\"kind\":\"" + kind + "\",\"popsize\":" + std::to_string(OP_POPSIZE)
+        + ",\"nbparam\":" + std::to_string(OP_NBPARAM) + ",\"nbit\":" + std::to_string(OP_NBIT)
+        + ",\"calls\":" + std::to_string(calls) + ",\"seconds\":" + BenchNumber(seconds)
+        + ",\"calls_per_sec\":" + BenchNumber(calls / seconds) + ",\"allocations_per_call\":" + BenchNumber((double)allocations / calls) + "}");
+}
+
+// one call selects whole mating population
+void BenchSelection(const BenchOptions& opt, BenchOutput& out, const char* name, void(*selection)(galgo::Population<TYPE>&), bool multiobjective = false)
+{
+    std::string full = std::string("operator/selection/") + name;
+    if (full.find(opt.filter) == std::string::npos) return;
+
+    BenchSetup<OP_NBIT> setup(opt, OP_POPSIZE, OP_NBPARAM, multiobjective);
+    galgo::Population<TYPE>& pop = setup.pop();
+    int n = opt.quick ? 200 : 2000;
+    uint64_t allocations = 0;
+    double seconds = BenchTime(opt, n, [&]() { pop.selecting(selection); }, allocations);
+    OperatorRow(out, full, "selection", n, seconds, allocations);
+}
+
+// one call creates two offspring from mating population
+void BenchCrossOver(const BenchOptions& opt, BenchOutput& out, const char* name, void(*crossover)(const galgo::Population<TYPE>&, galgo::CHR<TYPE>&, galgo::CHR<TYPE>&))
+{
+    std::string full = std::string("operator/crossover/") + name;
+    if (full.find(opt.filter) == std::string::npos) return;
+
+    BenchSetup<OP_NBIT> setup(opt, OP_POPSIZE, OP_NBPARAM, false);
+    galgo::Population<TYPE>& pop = setup.pop();
+    galgo::CHR<TYPE> chr1, chr2;
+    int n = opt.quick ? 5000 : 50000;
+    uint64_t allocations = 0;
+    // offspring are created empty for each call as in recombination(), some operators append their bits
+    double seconds = BenchTime(opt, n, [&]() {
+        chr1 = std::make_shared<galgo::Chromosome<TYPE>>(*setup.ga);
+        chr2 = std::make_shared<galgo::Chromosome<TYPE>>(*setup.ga);
+        crossover(pop, chr1, chr2);
+    }, allocations);
+    OperatorRow(out, full, "crossover", n, seconds, allocations);
+}
+
+// one call mutates one chromosome
+void BenchMutation(const BenchOptions& opt, BenchOutput& out, const char* name, void(*mutation)(galgo::CHR<TYPE>&))
+{
+    std::string full = std::string("operator/mutation/") + name;
+    if (full.find(opt.filter) == std::string::npos) return;
+
+    BenchSetup<OP_NBIT> setup(opt, OP_POPSIZE, OP_NBPARAM, false);
+    galgo::CHR<TYPE> chr = std::make_shared<galgo::Chromosome<TYPE>>(*setup.pop()(0));
+    int n = opt.quick ? 5000 : 50000;
+    uint64_t allocations = 0;
+    double seconds = BenchTime(opt, n, [&]() { mutation(chr); }, allocations);
+    OperatorRow(out, full, "mutation", n, seconds, allocations);
+}
+
+void BenchOperators(const BenchOptions& opt, BenchOutput& out)
+{
+    BenchSelection(opt, out, "RWS", RWS<TYPE>);
+    BenchSelection(opt, out, "SUS", SUS<TYPE>);
+    BenchSelection(opt, out, "RNK", RNK<TYPE>);
+    BenchSelection(opt, out, "RSP", RSP<TYPE>);
+    BenchSelection(opt, out, "TNT", TNT<TYPE>);
+    BenchSelection(opt, out, "TRS", TRS<TYPE>);
+    BenchSelection(opt, out, "PRT", PRT<TYPE>, true);
+
+    BenchCrossOver(opt, out, "P1XO", P1XO<TYPE>);
+    BenchCrossOver(opt, out, "P2XO", P2XO<TYPE>);
+    BenchCrossOver(opt, out, "UXO", UXO<TYPE>);
+    BenchCrossOver(opt, out, "RealValuedSimpleArithmeticRecombination", RealValuedSimpleArithmeticRecombination<TYPE>);
+    BenchCrossOver(opt, out, "RealValuedSingleArithmeticRecombination", RealValuedSingleArithmeticRecombination<TYPE>);
+    BenchCrossOver(opt, out, "RealValuedWholeArithmeticRecombination", RealValuedWholeArithmeticRecombination<TYPE>);
+
+    BenchMutation(opt, out, "SPM", SPM<TYPE>);
+    BenchMutation(opt, out, "BDM", BDM<TYPE>);
+    BenchMutation(opt, out, "UNM", UNM<TYPE>);
+    BenchMutation(opt, out, "GAM_UncorrelatedOneStepSizeFixed", GAM_UncorrelatedOneStepSizeFixed<TYPE>);
+    BenchMutation(opt, out, "GAM_UncorrelatedOneStepSizeBoundary", GAM_UncorrelatedOneStepSizeBoundary<TYPE>);
+    BenchMutation(opt, out, "GAM_UncorrelatedNStepSize", GAM_UncorrelatedNStepSize<TYPE>);
+    BenchMutation(opt, out, "GAM_UncorrelatedNStepSizeBoundary", GAM_UncorrelatedNStepSizeBoundary<TYPE>);
+    BenchMutation(opt, out, "GAM_sigma_adapting_per_generation", GAM_sigma_adapting_per_generation<TYPE>);
+    BenchMutation(opt, out, "GAM_sigma_adapting_per_mutation", GAM_sigma_adapting_per_mutation<TYPE>);
+}
+
+//------------------------------------------------------------------------------
+// run benchmarks
+//------------------------------------------------------------------------------
+struct RunCase
+{
+    const char* function;
+    int popsize;
+    int nbparam;
+    int nbit;
+    const char* objective;      // kind of objective ("" = ConfigInfo::Objective)
+
+    std::string name() const
+    {
+        return std::string("run/") + function + "/pop" + std::to_string(popsize) + "/param" + std::to_string(nbparam)
+            + "/bit" + std::to_string(nbit) + (*objective ? "/" : "") + objective;
+    }
+};
+
+template <typename O, int NBIT>
+void BenchRun(const BenchOptions& opt, BenchOutput& out, const RunCase& c, TYPE lo, TYPE hi, void(*objective)(galgo::ConfigInfo<TYPE>&))
+{
+    // about the same number of decoded parameters for every case
+    int nbgen = std::max(5, std::min(200, (opt.quick ? 20000 : 400000) / (c.popsize * c.nbparam)));
+
+    galgo::ConfigInfo<TYPE> config;
+    set_classic_config<TYPE>(config);
+    config.output = false;
+    config.popsize = c.popsize;
+    config.nbgen = nbgen;
+    objective(config);
+
+    std::vector<TYPE> lower(c.nbparam, lo), upper(c.nbparam, hi), initial;
+
+    double best = std::numeric_limits<double>::max();
+    uint64_t evaluations = 0;
+    uint64_t allocations = 0;
+    for (int r = 0; r < opt.repeat; ++r) {
+        galgo::rng.seed(opt.seed);
+        Counted<O>::count = 0;
+        galgo::GeneticAlgorithmN<TYPE, NBIT> ga(config, lower, upper, initial);
+        uint64_t first = BenchAllocations;
+        int64_t start = galgo::WallTime();
+        ga.run();
+        best = std::min(best, (galgo::WallTime() - start) * 1e-9);
+        allocations = BenchAllocations - first;
+        evaluations = Counted<O>::count;
+    }
+    BenchResult result = { c.name(), nbgen / best, (double)allocations / nbgen };
+    out.results.push_back(result);
+
+    out.row("{\"name\":\"" + c.name() + "\",\"kind\":\"run\",\"function\":\"" + c.function + "\",\"objective\":\"" + (*c.objective ? c.objective : "scalar")
+        + "\",\"popsize\":" + std::to_string(c.popsize)
+        + ",\"nbparam\":" + std::to_string(c.nbparam) + ",\"nbit\":" + std::to_string(c.nbit)
+        + ",\"generations\":" + std::to_string(nbgen) + ",\"evaluations\":" + std::to_string(evaluations) + ",\"seconds\":" + BenchNumber(best)
+        + ",\"generations_per_sec\":" + BenchNumber(result.gps) + ",\"evaluations_per_sec\":" + BenchNumber(evaluations / best)
+        + ",\"allocations\":" + std::to_string(allocations) + ",\"allocations_per_generation\":" + BenchNumber(result.apg) + "}");
+}
+
+// dispatch number of bits (template parameter)
+template <typename O>
+void BenchRun(const BenchOptions& opt, BenchOutput& out, const RunCase& c, TYPE lo, TYPE hi, void(*objective)(galgo::ConfigInfo<TYPE>&) = BenchScalar<O>)
+{
+    if (c.name().find(opt.filter) == std::string::npos) return;
+
+    if (c.nbit == 16) BenchRun<O, 16>(opt, out, c, lo, hi, objective);
+    else if (c.nbit == 32) BenchRun<O, 32>(opt, out, c, lo, hi, objective);
+    else BenchRun<O, 64>(opt, out, c, lo, hi, objective);
+}
+
+void BenchRuns(const BenchOptions& opt, BenchOutput& out)
+{
+    // classic functions with reference sizes
+    BenchRun<rastriginObjective<TYPE>>(opt, out, { "rastrigin", 100, 10, 32, "" }, (TYPE)-5.12, (TYPE)5.12);
+    BenchRun<GriewankObjective<TYPE>>(opt, out, { "griewank", 100, 10, 32, "" }, (TYPE)-600, (TYPE)600);
+    BenchRun<StyblinskiTangObjective<TYPE>>(opt, out, { "styblinski-tang", 100, 10, 32, "" }, (TYPE)-5, (TYPE)5);
+    BenchRun<RosenbrockObjective<TYPE>>(opt, out, { "rosenbrock", 100, 2, 32, "" }, (TYPE)-2, (TYPE)2);
+    BenchRun<AckleyObjective<TYPE>>(opt, out, { "ackley", 100, 2, 32, "" }, (TYPE)-4, (TYPE)5);
+
+    // one size varying at a time from reference sizes
+    for (int popsize : { 50, 400, 1600 }) {
+        BenchRun<rastriginObjective<TYPE>>(opt, out, { "rastrigin", popsize, 10, 32, "" }, (TYPE)-5.12, (TYPE)5.12);
+    }
+    for (int nbparam : { 2, 50, 200 }) {
+        BenchRun<rastriginObjective<TYPE>>(opt, out, { "rastrigin", 100, nbparam, 32, "" }, (TYPE)-5.12, (TYPE)5.12);
+    }
+    for (int nbit : { 16, 64 }) {
+        BenchRun<rastriginObjective<TYPE>>(opt, out, { "rastrigin", 100, 10, nbit, "" }, (TYPE)-5.12, (TYPE)5.12);
+    }
+    // objective kinds from reference sizes
+    BenchRun<rastriginObjective<TYPE>>(opt, out, { "rastrigin", 100, 10, 32, "batch" }, (TYPE)-5.12, (TYPE)5.12, BenchBatch<rastriginObjective<TYPE>>);
+    BenchRun<GriewankObjective<TYPE>>(opt, out, { "griewank", 100, 10, 32, "batch" }, (TYPE)-600, (TYPE)600, BenchBatch<GriewankObjective<TYPE>>);
+    BenchRun<StyblinskiTangObjective<TYPE>>(opt, out, { "styblinski-tang", 100, 10, 32, "batch" }, (TYPE)-5, (TYPE)5, BenchBatch<StyblinskiTangObjective<TYPE>>);
+    BenchRun<RosenbrockObjective<TYPE>>(opt, out, { "rosenbrock", 100, 2, 32, "batch" }, (TYPE)-2, (TYPE)2, BenchBatch<RosenbrockObjective<TYPE>>);
+    BenchRun<AckleyObjective<TYPE>>(opt, out, { "ackley", 100, 2, 32, "batch" }, (TYPE)-4, (TYPE)5, BenchBatch<AckleyObjective<TYPE>>);
+    BenchRun<rastriginObjective<TYPE>>(opt, out, { "rastrigin", 100, 10, 32, "span" }, (TYPE)-5.12, (TYPE)5.12, BenchSpan<rastriginObjective<TYPE>>);
+    BenchRun<GriewankObjective<TYPE>>(opt, out, { "griewank", 100, 10, 32, "span" }, (TYPE)-600, (TYPE)600, BenchSpan<GriewankObjective<TYPE>>);
+    BenchRun<StyblinskiTangObjective<TYPE>>(opt, out, { "styblinski-tang", 100, 10, 32, "span" }, (TYPE)-5, (TYPE)5, BenchSpan<StyblinskiTangObjective<TYPE>>);
+    BenchRun<rastriginObjective<TYPE>>(opt, out, { "rastrigin", 100, 10, 32, "bounded" }, (TYPE)-5.12, (TYPE)5.12, BenchBounded<rastriginObjective<TYPE>>);
+    BenchRun<rastriginObjective<TYPE>>(opt, out, { "rastrigin", 100, 10, 32, "constraintfirst" }, (TYPE)-5.12, (TYPE)5.12, BenchConstraintFirst<rastriginObjective<TYPE>>);
+}
+
+//------------------------------------------------------------------------------
+// comparison with baseline
+//------------------------------------------------------------------------------
+// value of numeric field key of JSON object on one line, NaN if missing
+inline double BenchField(const std::string& line, const std::string& key)
+{
+    size_t pos = line.find("\"" + key + "\":");
+    if (pos == std::string::npos) return std::numeric_limits<double>::quiet_NaN();
+    return std::strtod(line.c_str() + pos + key.size() + 3, nullptr);
+}
+
+// read run benchmarks of results written by galgo_bench
+std::vector<BenchResult> BenchLoad(const std::string& path)
+{
+    std::ifstream in(path);
+    if (!in) throw std::invalid_argument("cannot read baseline " + path);
+
+    std::vector<BenchResult> results;
+    std::string line;
+    while (std::getline(in, line)) {
+        size_t first = line.find("\"name\":\"");
+        if (first == std::string::npos || line.find("\"kind\":\"run\"") == std::string::npos) continue;
+        first += 8;
+        BenchResult r;
+        r.name = line.substr(first, line.find('"', first) - first);
+        r.gps = BenchField(line, "generations_per_sec");
+        r.apg = BenchField(line, "allocations_per_generation");
+        results.push_back(r);
+    }
+    return results;
+}
+
+// print table of deltas from baseline, return number of regressions
+int BenchCompare(const BenchOptions& opt, const std::vector<BenchResult>& current, const std::vector<BenchResult>& baseline, std::ostream& os)
+{
+    char line[256];
+    std::snprintf(line, sizeof(line), " %-46s | %11s %11s %8s | %11s %11s %8s | %s\n", "benchmark", "gen/s base", "gen/s", "delta", "alloc/gen b", "alloc/gen", "delta", "status");
+    os << "\n" << line << " " << std::string(std::strlen(line) - 2, '-') << "\n";
+
+    int compared = 0;
+    int regressions = 0;
+    for (const BenchResult& c : current) {
+        auto b = std::find_if(baseline.begin(), baseline.end(), [&c](const BenchResult& r) { return r.name == c.name; });
+        if (b == baseline.end()) {
+            std::snprintf(line, sizeof(line), " %-46s | %11s %11.1f %8s | %11s %11.1f %8s | new\n", c.name.c_str(), "-", c.gps, "", "-", c.apg, "");
+            os << line;
+            continue;
+        }
+        // relative deltas, allocations not compared when missing from baseline
+        double dgps = c.gps / b->gps - 1.0;
+        double dapg = std::isnan(b->apg) ? 0.0 : b->apg > 0.0 ? c.apg / b->apg - 1.0 : (c.apg > 0.0 ? 1.0 : 0.0);
+        bool slower = opt.throughput && dgps <= -opt.tolerance;
+        bool allocates = dapg > opt.alloctolerance;
+        std::snprintf(line, sizeof(line), " %-46s | %11.1f %11.1f %+7.1f%% | %11.1f %11.1f %+7.1f%% | %s\n", c.name.c_str(), b->gps, c.gps, 100.0 * dgps,
+            b->apg, c.apg, 100.0 * dapg, slower && allocates ? "SLOWER, MORE ALLOCATIONS" : slower ? "SLOWER" : allocates ? "MORE ALLOCATIONS" : "ok");
+        os << line;
+        compared++;
+        if (slower || allocates) regressions++;
+    }
+
+    os << "\n " << compared << " benchmark(s) compared with baseline, " << regressions << " regression(s) (tolerance: generations/sec ";
+    if (opt.throughput) os << "-" << 100.0 * opt.tolerance << "%";
+    else os << "not checked";
+    os << ", allocations/generation +" << 100.0 * opt.alloctolerance << "%)\n";
+    return regressions;
+}
+
+//------------------------------------------------------------------------------
+
+int main(int argc, char** argv)
+{
+    BenchOptions opt;
+    try {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            bool more = i + 1 < argc;
+            if (arg == "--quick") opt.quick = true;
+            else if (arg == "--filter" && more) opt.filter = argv[++i];
+            else if (arg == "--repeat" && more) opt.repeat = std::max(1, std::stoi(argv[++i]));
+            else if (arg == "--seed" && more) opt.seed = std::stoull(argv[++i]);
+            else if (arg == "--out" && more) opt.out = argv[++i];
+            else if (arg == "--baseline" && more) opt.baseline = argv[++i];
+            else if (arg == "--tolerance" && more) { opt.tolerance = std::stod(argv[++i]); opt.throughput = true; }
+            else if (arg == "--alloc-tolerance" && more) opt.alloctolerance = std::stod(argv[++i]);
+            else {
+                std::cerr << "usage: " << argv[0] << " [--quick] [--filter text] [--repeat n] [--seed n] [--out file]\n"
+                          << "       [--baseline file [--tolerance x] [--alloc-tolerance x]]\n";
+                return 2;
+            }
+        }
+    }
+    catch (const std::exception&) {
+        std::cerr << "galgo_bench: invalid argument value\n";
+        return 2;
+    }
+
+    std::vector<BenchResult> baseline;
+    try {
+        if (!opt.baseline.empty()) baseline = BenchLoad(opt.baseline);
+    }
+    catch (const std::exception& e) {
+        std::cerr << "galgo_bench: " << e.what() << "\n";
+        return 2;
+    }
+
+    // results on standard output, unless written to file or compared with baseline
+    std::ofstream file;
+    std::ostringstream discarded;
+    if (!opt.out.empty()) {
+        file.open(opt.out);
+        if (!file) {
+            std::cerr << "galgo_bench: cannot write " << opt.out << "\n";
+            return 2;
+        }
+    }
+    std::ostream& os = !opt.out.empty() ? (std::ostream&)file : opt.baseline.empty() ? (std::ostream&)std::cout : (std::ostream&)discarded;
+
+    std::vector<BenchResult> results;
+    {
+        BenchOutput out(os, opt);
+        BenchOperators(opt, out);
+        BenchRuns(opt, out);
+        results = out.results;
+    }
+
+    if (opt.baseline.empty()) return 0;
+    return BenchCompare(opt, results, baseline, std::cout) > 0 ? 1 : 0;
+}
@@ -85,6 +85,26 @@ double pso_styb_tang(std::vector< T > particle)
     return (result / 2.);
 }
 
+//--------------------------
+// batch helpers (ConfigInfo::BatchObjective): x holds one row of nbparam parameters per chromosome,
+// batch objectives work column by column on all rows so that loops run over contiguous arrays
+//--------------------------
+// col[r] = x[r][k]
+template <typename T>
+void BatchColumn(const std::vector<T>& x, int nbparam, int k, std::vector<double>& col)
+{
+    size_t nrow = x.size() / nbparam;
+    col.resize(nrow);
+    for (size_t r = 0; r < nrow; r++) col[r] = (double)x[r * nbparam + k];
+}
+
+// result[r] = { v[r] }, keeping capacity of result vectors
+inline void BatchResult(const std::vector<double>& v, std::vector<std::vector<double>>& result)
+{
+    result.resize(v.size());
+    for (size_t r = 0; r < v.size(); r++) result[r].assign(1, v[r]);
+}
+
 //--------------------------
 // Objectives
 //--------------------------
@@ -100,6 +120,50 @@ public:
         double obj = -pso_rastrigin<double>(xd);
         return { obj };
     }
+
+    // allocation free version (ConfigInfo::ObjectiveSpan)
+    static void ObjectiveSpan(galgo::Span<const T> x, galgo::Span<double> result, void*, galgo::ScratchArena&)
+    {
+        double sum = 10. * (double)x.size();
+        for (size_t i = 0; i < x.size(); i++) {
+            double d = (double)x[i];
+            sum += d * d - (10. * cos(2. * 3.14159 * d));
+        }
+        result[0] = -sum;
+    }
+
+    // batch version (ConfigInfo::BatchObjective)
+    static void BatchObjective(const std::vector<T>& x, int nbparam, std::vector<std::vector<double>>& result)
+    {
+        static thread_local std::vector<double> col, c, sum;
+        size_t nrow = x.size() / nbparam;
+        sum.assign(nrow, 10. * nbparam);
+        c.resize(nrow);
+        for (int k = 0; k < nbparam; k++) {
+            BatchColumn(x, nbparam, k, col);
+            for (size_t r = 0; r < nrow; r++) c[r] = 2. * 3.14159 * col[r];
+            galgo::VecCos(c.data(), c.data(), (int)nrow);
+            for (size_t r = 0; r < nrow; r++) sum[r] += col[r] * col[r] - (10. * c[r]);
+        }
+        for (size_t r = 0; r < nrow; r++) sum[r] = -sum[r];
+        BatchResult(sum, result);
+    }
+
+    // early abort version (ConfigInfo::ObjectiveBounded): every term adds a value >= 0 to sum,
+    // the objective cannot get back above bound once -sum is below it
+    static std::vector<double> ObjectiveBounded(const std::vector<T>& x, double bound, bool& pruned)
+    {
+        double sum = 0.0;
+        for (size_t i = 0; i < x.size(); i++) {
+            double d = (double)x[i];
+            sum += 10. + d * d - (10. * cos(2. * 3.14159 * d));
+            if (-sum < bound) {
+                pruned = true;
+                break;
+            }
+        }
+        return { -sum };
+    }
 };
 
 template <typename T>
@@ -114,6 +178,40 @@ public:
         double obj = -pso_griewank<double>(xd);
         return { obj };
     }
+
+    // allocation free version (ConfigInfo::ObjectiveSpan)
+    static void ObjectiveSpan(galgo::Span<const T> x, galgo::Span<double> result, void*, galgo::ScratchArena&)
+    {
+        double sum(0.), product(1.);
+        for (size_t i = 0; i < x.size(); i++) {
+            double d = (double)x[i];
+            sum += d * d;
+            product *= cos(d / sqrt((double)i + 1));
+        }
+        result[0] = -(1. + (sum / 4000.) - product);
+    }
+
+    // batch version (ConfigInfo::BatchObjective)
+    static void BatchObjective(const std::vector<T>& x, int nbparam, std::vector<std::vector<double>>& result)
+    {
+        static thread_local std::vector<double> col, c, sum, product;
+        size_t nrow = x.size() / nbparam;
+        sum.assign(nrow, 0.);
+        product.assign(nrow, 1.);
+        c.resize(nrow);
+        for (int k = 0; k < nbparam; k++) {
+            BatchColumn(x, nbparam, k, col);
+            double d = sqrt((double)k + 1);
+            for (size_t r = 0; r < nrow; r++) c[r] = col[r] / d;
+            galgo::VecCos(c.data(), c.data(), (int)nrow);
+            for (size_t r = 0; r < nrow; r++) {
+                sum[r] += col[r] * col[r];
+                product[r] *= c[r];
+            }
+        }
+        for (size_t r = 0; r < nrow; r++) sum[r] = -(1. + (sum[r] / 4000.) - product[r]);
+        BatchResult(sum, result);
+    }
 };
 
 template <typename T>
@@ -128,6 +226,35 @@ public:
         double obj = -pso_styb_tang<double>(xd);
         return { obj };
     }
+
+    // allocation free version (ConfigInfo::ObjectiveSpan)
+    static void ObjectiveSpan(galgo::Span<const T> x, galgo::Span<double> result, void*, galgo::ScratchArena&)
+    {
+        double sum(0.);
+        for (size_t i = 0; i < x.size(); i++) {
+            double d = (double)x[i];
+            double d2 = d * d;
+            sum += d2 * d2 - (16. * d2) + (5. * d);
+        }
+        result[0] = -(sum / 2.);
+    }
+
+    // batch version (ConfigInfo::BatchObjective)
+    static void BatchObjective(const std::vector<T>& x, int nbparam, std::vector<std::vector<double>>& result)
+    {
+        static thread_local std::vector<double> col, sum;
+        size_t nrow = x.size() / nbparam;
+        sum.assign(nrow, 0.);
+        for (int k = 0; k < nbparam; k++) {
+            BatchColumn(x, nbparam, k, col);
+            for (size_t r = 0; r < nrow; r++) {
+                double d2 = col[r] * col[r];
+                sum[r] += d2 * d2 - (16. * d2) + (5. * col[r]);
+            }
+        }
+        for (size_t r = 0; r < nrow; r++) sum[r] = -(sum[r] / 2.);
+        BatchResult(sum, result);
+    }
 };
 
 template <typename T>
@@ -144,6 +271,22 @@ public:
         return { obj };
     }
     // NB: GALGO maximize by default so we will maximize -f(x,y)
+
+    // batch version (ConfigInfo::BatchObjective)
+    static void BatchObjective(const std::vector<T>& x, int nbparam, std::vector<std::vector<double>>& result)
+    {
+        static thread_local std::vector<double> x0, x1, obj;
+        size_t nrow = x.size() / nbparam;
+        BatchColumn(x, nbparam, 0, x0);
+        BatchColumn(x, nbparam, 1, x1);
+        obj.resize(nrow);
+        for (size_t r = 0; r < nrow; r++) {
+            double a = 1.0 - x0[r];
+            double b = x1[r] - x0[r] * x0[r];
+            obj[r] = -(a * a + 100 * b * b);
+        }
+        BatchResult(obj, result);
+    }
 };
 
 template <typename T>
@@ -157,6 +300,32 @@ public:
         double obj = -Ackley<double>(x0, x1);
         return { obj };
     }
+
+    // batch version (ConfigInfo::BatchObjective)
+    static void BatchObjective(const std::vector<T>& x, int nbparam, std::vector<std::vector<double>>& result)
+    {
+        const double pi = 3.14159265358979323846;
+        static thread_local std::vector<double> x0, x1, c0, c1, e0, e1;
+        size_t nrow = x.size() / nbparam;
+        BatchColumn(x, nbparam, 0, x0);
+        BatchColumn(x, nbparam, 1, x1);
+        c0.resize(nrow);
+        c1.resize(nrow);
+        e0.resize(nrow);
+        e1.resize(nrow);
+        for (size_t r = 0; r < nrow; r++) {
+            c0[r] = 2 * pi * x0[r];
+            c1[r] = 2 * pi * x1[r];
+            e0[r] = -0.2 * std::sqrt(0.5 * (x0[r] * x0[r] + x1[r] * x1[r]));
+        }
+        galgo::VecCos(c0.data(), c0.data(), (int)nrow);
+        galgo::VecCos(c1.data(), c1.data(), (int)nrow);
+        for (size_t r = 0; r < nrow; r++) e1[r] = 0.5 * (c0[r] + c1[r]);
+        galgo::VecExp(e0.data(), e0.data(), (int)nrow);
+        galgo::VecExp(e1.data(), e1.data(), (int)nrow);
+        for (size_t r = 0; r < nrow; r++) e0[r] = -(-20 * e0[r] - e1[r] + std::exp(1) + 20);
+        BatchResult(e0, result);
+    }
 };
 
 template <typename T>
@@ -206,9 +375,70 @@ public:
         double obj = sum;
         return{ obj }; //max= -1.8013(2D) at (2.20,1.57)/-4.687658(5D)/-9.66015(10D)
     }
+
+    // batch version (ConfigInfo::BatchObjective), pow(s, 20) by repeated squaring
+    static void BatchObjective(const std::vector<T>& x, int nbparam, std::vector<std::vector<double>>& result)
+    {
+        const double pi = 3.14159265358979323846;
+        static thread_local std::vector<double> col, s, t, sum;
+        size_t nrow = x.size() / nbparam;
+        sum.assign(nrow, 0.);
+        s.resize(nrow);
+        t.resize(nrow);
+        for (int k = 0; k < nbparam; k++) {
+            BatchColumn(x, nbparam, k, col);
+            for (size_t r = 0; r < nrow; r++) t[r] = k * col[r] * col[r] / pi;
+            galgo::VecSin(col.data(), s.data(), (int)nrow);
+            galgo::VecSin(t.data(), t.data(), (int)nrow);
+            for (size_t r = 0; r < nrow; r++) {
+                double t2 = t[r] * t[r];
+                double t4 = t2 * t2;
+                double t16 = t4 * t4 * t4 * t4;
+                sum[r] += s[r] * (t16 * t4);
+            }
+        }
+        BatchResult(sum, result);
+    }
 };
 
 
+// ZDT1 function (2 objectives, multi-objective mode), parameters in [0,1]
+// Pareto front: x[1...n-1] = 0, f2 = 1 - sqrt(f1)
+template <typename T>
+class ZDT1Objective
+{
+public:
+    static std::vector<double> Objective(const std::vector<T>& x)
+    {
+        double g = 0.0;
+        for (size_t i = 1; i < x.size(); i++) g += (double)x[i];
+        g = 1.0 + 9.0 * g / (double)(x.size() - 1);
+        double f1 = (double)x[0];
+        double f2 = g * (1.0 - sqrt(f1 / g));
+        return { -f1, -f2 };
+    }
+};
+
+// DTLZ2 function (3 objectives, multi-objective mode), parameters in [0,1]
+// Pareto front: x[2...n-1] = 0.5, f1^2 + f2^2 + f3^2 = 1
+template <typename T>
+class DTLZ2Objective
+{
+public:
+    static std::vector<double> Objective(const std::vector<T>& x)
+    {
+        double g = 0.0;
+        for (size_t i = 2; i < x.size(); i++) g += ((double)x[i] - 0.5) * ((double)x[i] - 0.5);
+        const double pi = 3.14159265358979323846;
+        double a = (double)x[0] * pi / 2.0;
+        double b = (double)x[1] * pi / 2.0;
+        double f1 = (1.0 + g) * cos(a) * cos(b);
+        double f2 = (1.0 + g) * cos(a) * sin(b);
+        double f3 = (1.0 + g) * sin(a);
+        return { -f1, -f2, -f3 };
+    }
+};
+
 template <typename _TYPE>
 void set_classic_config(galgo::ConfigInfo<_TYPE>& config)
 {
@@ -327,4 +557,563 @@ void test_classic()
 
     }
 }
+
+//--------------------------
+// fixed size genetic algorithm example (galgo::FixedGeneticAlgorithm):
+// single objective, parameters packed in std::array, operators TNT, P1XO and SPM
+//--------------------------
+template <typename T, size_t N>
+double rastriginFixed(const std::array<T, N>& x)
+{
+    double sum = 10. * (double)N;
+    for (size_t i = 0; i < N; i++) {
+        double d = (double)x[i];
+        sum += d * d - (10. * cos(2. * 3.14159 * d));
+    }
+    return -sum;
+}
+
+void test_fixed_ga()
+{
+    using _TYPE = double;
+    const int NBIT = 32;
+
+    galgo::ConfigInfo<_TYPE> config;
+    config.Selection = TNT;
+    config.elitpop = 5;
+    config.popsize = 100;
+    config.nbgen = 400;
+    config.output = true;
+
+    std::cout << std::endl;
+    std::cout << "Rastrigin function (fixed size genetic algorithm)";
+    galgo::Parameter<_TYPE, NBIT> par1({ (_TYPE)-4.0,(_TYPE)5.0 });
+    galgo::Parameter<_TYPE, NBIT> par2({ (_TYPE)-4.0,(_TYPE)5.0 });
+    galgo::Parameter<_TYPE, NBIT> par3({ (_TYPE)-4.0,(_TYPE)5.0 });
+
+    galgo::FixedGeneticAlgorithm<_TYPE, NBIT, NBIT, NBIT> ga(rastriginFixed<_TYPE, 3>, config, par1, par2, par3);
+    ga.run();
+}
+//--------------------------
+// policy based genetic algorithm example (galgo::GeneticAlgorithm<T, Policies...>): operators and
+// objective resolved at compile time (TNT, P1XO, SPM, Rastrigin)
+//--------------------------
+void test_policy_ga()
+{
+    using _TYPE = double;
+    const int NBIT = 32;
+
+    galgo::ConfigInfo<_TYPE> config;
+    config.mutinfo._type = galgo::MutationType::MutationSPM;
+    config.elitpop = 5;
+    config.popsize = 100;
+    config.nbgen = 400;
+    config.output = true;
+
+    std::cout << std::endl;
+    std::cout << "Rastrigin function (policy based genetic algorithm)";
+    galgo::Parameter<_TYPE, NBIT> par1({ (_TYPE)-4.0,(_TYPE)5.0 });
+    galgo::Parameter<_TYPE, NBIT> par2({ (_TYPE)-4.0,(_TYPE)5.0 });
+    galgo::Parameter<_TYPE, NBIT> par3({ (_TYPE)-4.0,(_TYPE)5.0 });
+
+    galgo::GeneticAlgorithm<_TYPE,
+        galgo::SelectionFn<_TYPE, TNT<_TYPE>>,
+        galgo::CrossOverFn<_TYPE, P1XO<_TYPE>>,
+        galgo::MutationFn<_TYPE, SPM<_TYPE>>,
+        galgo::ObjectiveFn<_TYPE, rastriginObjective<_TYPE>::Objective>> ga(config, par1, par2, par3);
+    ga.run();
+}
+
+//--------------------------
+// sparse genetic algorithm example (galgo::SparseGeneticAlgorithm): feature selection,
+// a few relevant features among many, objective receives the indexes of features selected
+//--------------------------
+const int SPARSE_NBBIT = 100000;
+
+std::vector<double> SparseFeatureObjective(const std::vector<int>& x)
+{
+    // relevant features: multiples of 5000
+    double obj = 0.0;
+    for (int i : x) obj += (i % 5000 == 0) ? 1.0 : -0.1;
+    return { obj };
+}
+
+void test_sparse_ga()
+{
+    galgo::ConfigInfo<int> config;
+    config.Objective = SparseFeatureObjective;
+    config.covrate = 0.8;
+    config.mutrate = 2.0 / SPARSE_NBBIT;
+    config.elitpop = 2;
+    config.popsize = 100;
+    config.nbgen = 400;
+    config.genstep = 40;
+    config.output = true;
+
+    std::cout << std::endl;
+    std::cout << "Feature selection (sparse genetic algorithm, 20 relevant features of " << SPARSE_NBBIT << ")";
+    galgo::SparseGeneticAlgorithm ga(config, SPARSE_NBBIT, 20.0 / SPARSE_NBBIT);
+    ga.run();
+
+    // round-trip to dense representation (string of bits, as Chromosome<T>::getBits())
+    std::string dense = galgo::SparseToBits(ga.result(), ga.nbbit);
+    galgo::SparseChromosome chr;
+    galgo::SparseFromBits(dense, chr);
+    std::cout << " Dense round-trip: " << std::count(dense.begin(), dense.end(), '1') << " bits set of " << dense.size();
+    std::cout << (chr.bits == ga.result().bits ? ", identical" : ", MISMATCH") << "\n";
+}
+
+//--------------------------
+// checkpoint example (ConfigInfo::checkpoint, checkpointstep, resume): a run interrupted at
+// generation 20 and resumed from its checkpoint must end exactly as an uninterrupted run
+// (population compared bit by bit; single threaded build, threads share the random generator);
+// resumed run is seeded differently, random generator state must come from checkpoint
+//--------------------------
+std::vector<std::string> checkpoint_run(int nbgen, int step, bool resume, double ratio, bool multiobjective, unsigned seed)
+{
+    using _TYPE = double;
+    const int NBIT = 32;
+
+    galgo::ConfigInfo<_TYPE> config;
+    config.Objective = multiobjective ? ZDT1Objective<_TYPE>::Objective : rastriginObjective<_TYPE>::Objective;
+    config.multiobjective = multiobjective;
+    config.pipeline_ratio = ratio;
+    config.elitpop = 3;
+    config.popsize = 60;
+    config.nbgen = nbgen;
+    config.checkpoint = "galgo_checkpoint.bin";
+    config.checkpointstep = step;
+    config.resume = resume;
+
+    galgo::rng.seed(seed);
+    galgo::Parameter<_TYPE, NBIT> par1({ (_TYPE)0.0,(_TYPE)1.0 });
+    galgo::Parameter<_TYPE, NBIT> par2({ (_TYPE)0.0,(_TYPE)1.0 });
+    galgo::Parameter<_TYPE, NBIT> par3({ (_TYPE)0.0,(_TYPE)1.0 });
+    galgo::GeneticAlgorithm<_TYPE> ga(config, par1, par2, par3);
+    ga.run();
+
+    std::vector<std::string> pop;
+    for (const auto& chr : ga.get_pop().get_curpop()) {
+        std::ostringstream os;
+        os << chr->getBits() << " " << std::setprecision(17) << chr->getTotal();
+        pop.push_back(os.str());
+    }
+    return pop;
+}
+
+void test_checkpoint()
+{
+    std::cout << std::endl;
+    std::cout << "Checkpoint resume (40 generations, interrupted at generation 20)\n";
+    const char* names[] = { "plain", "pipelined", "NSGA-II" };
+    const double ratios[] = { 0.0, 0.3, 0.3 };
+    for (int k = 0; k < 3; k++) {
+        std::remove("galgo_checkpoint.bin");
+        std::vector<std::string> uninterrupted = checkpoint_run(40, 0, false, ratios[k], k == 2, 2018);
+        checkpoint_run(20, 20, false, ratios[k], k == 2, 2018);
+        std::vector<std::string> resumed = checkpoint_run(40, 0, true, ratios[k], k == 2, 1);
+        std::cout << " " << names[k] << ": " << (resumed == uninterrupted ? "identical" : "MISMATCH") << "\n";
+    }
+    std::remove("galgo_checkpoint.bin");
+}
+
+//--------------------------
+// history log example (ConfigInfo::history): every evaluation of a run is logged, then read back
+// with HistoryReader; best logged evaluation must be the best chromosome of the run, and a block
+// whose number of rows does not fit its size must be rejected
+//--------------------------
+void test_history()
+{
+    using _TYPE = double;
+    const int NBIT = 32;
+
+    galgo::Parameter<_TYPE, NBIT> par1({ (_TYPE)-4.0,(_TYPE)5.0 });
+    galgo::Parameter<_TYPE, NBIT> par2({ (_TYPE)-4.0,(_TYPE)5.0 });
+    galgo::Parameter<_TYPE, NBIT> par3({ (_TYPE)-4.0,(_TYPE)5.0 });
+
+    std::cout << std::endl;
+    std::cout << "History log round-trip (Rastrigin function)\n";
+    std::string bits;
+    double total;
+    {
+        galgo::HistoryLog<_TYPE> log("galgo_history.bin", 3, 3 * NBIT, 1, 256);
+        galgo::ConfigInfo<_TYPE> config;
+        config.Objective = rastriginObjective<_TYPE>::Objective;
+        config.popsize = 100;
+        config.nbgen = 100;
+        config.history = &log;
+        galgo::GeneticAlgorithm<_TYPE> ga(config, par1, par2, par3);
+        ga.run();
+        bits = ga.result()->getBits();
+        total = ga.result()->getTotal();
+    }
+
+    galgo::HistoryReader<_TYPE> reader("galgo_history.bin");
+    int bestblock = 0;
+    int bestrow = 0;
+    for (int i = 0; i < reader.nbblock(); i++) {
+        const galgo::HistoryBlock<_TYPE>& b = reader.block(i);
+        for (int r = 0; r < b.nbrow; r++) {
+            if (b.result[0][r] > reader.block(bestblock).result[0][bestrow]) { bestblock = i; bestrow = r; }
+        }
+    }
+    const galgo::HistoryBlock<_TYPE>& b = reader.block(bestblock);
+    std::string logged(reader.nbbit(), '0');
+    for (int k = 0; k < reader.nbbit(); k++) logged[k] = b.bit(bestrow, k) ? '1' : '0';
+    std::cout << " " << reader.size() << " evaluations in " << reader.nbblock() << " blocks, best logged evaluation ";
+    std::cout << (logged == bits && b.result[0][bestrow] == total ? "identical to result" : "MISMATCH") << "\n";
+
+    // corrupting number of rows of first block
+    std::vector<char> data;
+    galgo::ReadCheckpoint("galgo_history.bin", data);
+    galgo::HistoryBlockHeader bh;
+    size_t pos = galgo::HistoryColumnSize(1, sizeof(galgo::HistoryHeader));
+    std::memcpy(&bh, data.data() + pos, sizeof(bh));
+    bh.nbrow *= 4;
+    std::memcpy(data.data() + pos, &bh, sizeof(bh));
+    galgo::WriteCheckpoint("galgo_history.bin", data);
+    try {
+        galgo::HistoryReader<_TYPE> corrupted("galgo_history.bin");
+        std::cout << " Corrupted block: MISSED\n";
+    } catch (const std::invalid_argument&) {
+        std::cout << " Corrupted block: rejected\n";
+    }
+    std::remove("galgo_history.bin");
+}
+
+//--------------------------
+// cellular genetic algorithm example (galgo::CellularGeneticAlgorithm): 16x16 torus, chromosomes
+// mate with their neighbours (radius 1), tiles of 8x8 cells evolved in parallel
+//--------------------------
+void test_cellular_ga()
+{
+    using _TYPE = double;
+    const int NBIT = 32;
+
+    galgo::ConfigInfo<_TYPE> config;
+    config.Objective = rastriginObjective<_TYPE>::Objective;
+    config.covrate = 0.8;
+    config.mutrate = 0.05;
+    config.tntsize = 2;
+    config.nbgen = 200;
+    config.genstep = 20;
+    config.output = true;
+
+    std::cout << std::endl;
+    std::cout << "Rastrigin function (cellular genetic algorithm, 16x16 grid)";
+    galgo::Parameter<_TYPE, NBIT> par1({ (_TYPE)-4.0,(_TYPE)5.0 });
+    galgo::Parameter<_TYPE, NBIT> par2({ (_TYPE)-4.0,(_TYPE)5.0 });
+    galgo::Parameter<_TYPE, NBIT> par3({ (_TYPE)-4.0,(_TYPE)5.0 });
+
+    galgo::CellularGeneticAlgorithm<_TYPE> ga(config, 16, 16, par1, par2, par3);
+    ga.run();
+}
+
+//--------------------------
+// Pareto archive example (ConfigInfo::archive): archive fed by NSGA-II runs with 2 (ZDT1) and 3
+// (DTLZ2) objectives must hold no dominated pair, and its hypervolume must match a brute force
+// computation on the grid of archived coordinates (2 objectives) or a Monte Carlo estimate
+// (3 objectives, 200000 samples)
+//--------------------------
+double pareto_hypervolume(const std::vector<std::vector<double>>& front, const std::vector<double>& ref)
+{
+    // brute force on the grid of coordinates
+    if (ref.size() == 2) {
+        std::vector<double> xs = { ref[0] }, ys = { ref[1] };
+        for (const auto& y : front) { xs.push_back(y[0]); ys.push_back(y[1]); }
+        std::sort(xs.begin(), xs.end());
+        std::sort(ys.begin(), ys.end());
+        double hv = 0.0;
+        for (size_t i = 0; i + 1 < xs.size(); i++) {
+            for (size_t j = 0; j + 1 < ys.size(); j++) {
+                bool covered = std::any_of(front.cbegin(), front.cend(), [&](const std::vector<double>& y) { return y[0] >= xs[i + 1] && y[1] >= ys[j + 1]; });
+                if (covered) hv += (xs[i + 1] - xs[i]) * (ys[j + 1] - ys[j]);
+            }
+        }
+        return hv;
+    }
+    // Monte Carlo in the box between reference point and ideal point
+    std::vector<double> ideal = ref;
+    for (const auto& y : front) {
+        for (size_t k = 0; k < ref.size(); k++) ideal[k] = std::max(ideal[k], y[k]);
+    }
+    double volume = 1.0;
+    for (size_t k = 0; k < ref.size(); k++) volume *= ideal[k] - ref[k];
+    std::mt19937 gen(2018);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    const int nbsample = 200000;
+    int hit = 0;
+    std::vector<double> p(ref.size());
+    for (int s = 0; s < nbsample; s++) {
+        for (size_t k = 0; k < ref.size(); k++) p[k] = ref[k] + uniform(gen) * (ideal[k] - ref[k]);
+        for (const auto& y : front) {
+            size_t k = 0;
+            while (k < p.size() && y[k] >= p[k]) k++;
+            if (k == p.size()) { hit++; break; }
+        }
+    }
+    return volume * hit / nbsample;
+}
+
+void test_pareto_archive()
+{
+    using _TYPE = double;
+    const int NBIT = 32;
+
+    std::cout << std::endl;
+    std::cout << "Pareto archive (NSGA-II, ZDT1 and DTLZ2 functions)\n";
+    for (int nbobj = 2; nbobj <= 3; nbobj++) {
+        galgo::ParetoArchive<_TYPE> archive(200);
+        std::vector<double> ref(nbobj, nbobj == 2 ? -11.0 : -1.5);
+        archive.setReference(ref);
+
+        galgo::ConfigInfo<_TYPE> config;
+        config.Objective = nbobj == 2 ? ZDT1Objective<_TYPE>::Objective : DTLZ2Objective<_TYPE>::Objective;
+        config.multiobjective = true;
+        config.popsize = 100;
+        config.nbgen = 100;
+        config.archive = &archive;
+
+        galgo::Parameter<_TYPE, NBIT> par1({ (_TYPE)0.0,(_TYPE)1.0 });
+        galgo::Parameter<_TYPE, NBIT> par2({ (_TYPE)0.0,(_TYPE)1.0 });
+        galgo::Parameter<_TYPE, NBIT> par3({ (_TYPE)0.0,(_TYPE)1.0 });
+        galgo::GeneticAlgorithm<_TYPE> ga(config, par1, par2, par3);
+        ga.run();
+
+        std::vector<std::vector<double>> front;
+        for (const auto& chr : archive.solutions()) front.push_back(chr->getResult());
+        int dominated = 0;
+        for (size_t i = 0; i < front.size(); i++) {
+            for (size_t j = 0; j < front.size(); j++) {
+                if (i == j) continue;
+                bool weakly = true;
+                for (int k = 0; k < nbobj; k++) weakly = weakly && front[i][k] >= front[j][k];
+                if (weakly) dominated++;
+            }
+        }
+        double hv = archive.hypervolume();
+        double expected = pareto_hypervolume(front, ref);
+        double error = std::fabs(hv - expected) / expected;
+        std::cout << " " << nbobj << " objectives: " << archive.size() << " chromosomes, " << dominated << " dominated pairs, hypervolume " << hv;
+        std::cout << (nbobj == 2 ? " (brute force " : " (Monte Carlo ") << expected << ", ";
+        std::cout << ((nbobj == 2 ? error < 1e-9 : error < 0.02) ? "match" : "MISMATCH") << ")\n";
+    }
+}
+
+//--------------------------
+// bit-sliced population example (galgo::BitSlicedPopulation): population of 150 chromosomes of 90
+// bits (last block and last word partially used) loaded, stored back and reloaded after a bulk
+// mutation must round-trip bit by bit, and popcount() and weighted() must match per-chromosome
+// counts exactly (weights summed in same bit order)
+//--------------------------
+void test_bitsliced_population()
+{
+    using _TYPE = double;
+    const int NBIT = 30;
+
+    galgo::ConfigInfo<_TYPE> config;
+    config.Objective = rastriginObjective<_TYPE>::Objective;
+    config.popsize = 150;
+    config.nbgen = 10;
+
+    galgo::Parameter<_TYPE, NBIT> par1({ (_TYPE)-4.0,(_TYPE)5.0 });
+    galgo::Parameter<_TYPE, NBIT> par2({ (_TYPE)-4.0,(_TYPE)5.0 });
+    galgo::Parameter<_TYPE, NBIT> par3({ (_TYPE)-4.0,(_TYPE)5.0 });
+    galgo::GeneticAlgorithm<_TYPE> ga(config, par1, par2, par3);
+    ga.run();
+
+    std::vector<galgo::CHR<_TYPE>> pop;
+    for (const auto& chr : ga.get_pop().get_curpop()) pop.push_back(std::make_shared<galgo::Chromosome<_TYPE>>(*chr));
+
+    std::cout << std::endl;
+    std::cout << "Bit-sliced population (" << pop.size() << " chromosomes of " << pop[0]->size() << " bits)\n";
+
+    // bits of sliced population and chromosomes must be identical
+    auto identical = [](const galgo::BitSlicedPopulation<_TYPE>& sliced, const std::vector<galgo::CHR<_TYPE>>& chrs) {
+        if (sliced.size() != (int)chrs.size()) return false;
+        for (int i = 0; i < sliced.size(); i++) {
+            const std::string& bits = chrs[i]->getBits();
+            if ((int)bits.size() != sliced.nbbit()) return false;
+            for (int k = 0; k < sliced.nbbit(); k++) {
+                if (sliced.getBit(i, k) != (bits[k] == '1')) return false;
+            }
+        }
+        return true;
+    };
+
+    galgo::BitSlicedPopulation<_TYPE> sliced;
+    sliced.load(pop);
+    bool loaded = identical(sliced, pop);
+
+    std::vector<std::string> before;
+    for (const auto& chr : pop) before.push_back(chr->getBits());
+    sliced.store(pop);
+    bool stored = true;
+    for (size_t i = 0; i < pop.size(); i++) stored = stored && pop[i]->getBits() == before[i];
+
+    sliced.SPM(0.1);
+    sliced.store(pop);
+    galgo::BitSlicedPopulation<_TYPE> reloaded;
+    reloaded.load(pop);
+    bool mutated = identical(sliced, pop) && identical(reloaded, pop);
+    std::cout << " load: " << (loaded ? "identical" : "MISMATCH") << ", store: " << (stored ? "identical" : "MISMATCH");
+    std::cout << ", mutated round-trip: " << (mutated ? "identical" : "MISMATCH") << "\n";
+
+    std::mt19937 gen(2018);
+    std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+    std::vector<double> w(sliced.nbbit());
+    for (auto& x : w) x = uniform(gen);
+    std::vector<int> ones;
+    std::vector<double> sum;
+    sliced.popcount(ones);
+    sliced.weighted(w, sum);
+    bool counted = (int)ones.size() == sliced.size();
+    bool summed = (int)sum.size() == sliced.size();
+    for (int i = 0; counted && summed && i < sliced.size(); i++) {
+        const std::string& bits = pop[i]->getBits();
+        double expected = 0.0;
+        for (int k = 0; k < sliced.nbbit(); k++) if (bits[k] == '1') expected += w[k];
+        counted = ones[i] == (int)std::count(bits.begin(), bits.end(), '1');
+        summed = sum[i] == expected;
+    }
+    std::cout << " popcount: " << (counted ? "identical" : "MISMATCH") << ", weighted: " << (summed ? "identical" : "MISMATCH") << "\n";
+}
+
+//--------------------------
+// reporter and trace example (ConfigInfo::reporter, ConfigInfo::trace): run reported as JSON
+// lines and traced with small ring buffers (8 events, drained into file whenever full); every
+// reported line and the whole trace file must be valid JSON
+//--------------------------
+bool json_value(const std::string& s, size_t& i);
+
+void json_space(const std::string& s, size_t& i)
+{
+    while (i < s.size() && (s[i] == ' ' || s[i] == '\t' || s[i] == '\n' || s[i] == '\r')) i++;
+}
+
+bool json_string(const std::string& s, size_t& i)
+{
+    if (i >= s.size() || s[i] != '"') return false;
+    for (i++; i < s.size() && s[i] != '"'; i++) {
+        if ((unsigned char)s[i] < 0x20) return false;
+        if (s[i] == '\\' && ++i == s.size()) return false;
+    }
+    if (i == s.size()) return false;
+    i++;
+    return true;
+}
+
+bool json_number(const std::string& s, size_t& i)
+{
+    size_t first = i;
+    if (i < s.size() && s[i] == '-') i++;
+    size_t digits = i;
+    while (i < s.size() && s[i] >= '0' && s[i] <= '9') i++;
+    if (i == digits || (s[digits] == '0' && i > digits + 1)) return false;
+    if (i < s.size() && s[i] == '.') {
+        size_t fraction = ++i;
+        while (i < s.size() && s[i] >= '0' && s[i] <= '9') i++;
+        if (i == fraction) return false;
+    }
+    if (i < s.size() && (s[i] == 'e' || s[i] == 'E')) {
+        i++;
+        if (i < s.size() && (s[i] == '+' || s[i] == '-')) i++;
+        size_t exponent = i;
+        while (i < s.size() && s[i] >= '0' && s[i] <= '9') i++;
+        if (i == exponent) return false;
+    }
+    return i > first;
+}
+
+// comma separated values (or "key":value members) up to closing character
+bool json_list(const std::string& s, size_t& i, char close, bool members)
+{
+    i++;
+    json_space(s, i);
+    if (i < s.size() && s[i] == close) { i++; return true; }
+    for (;;) {
+        if (members) {
+            if (!json_string(s, i)) return false;
+            json_space(s, i);
+            if (i >= s.size() || s[i++] != ':') return false;
+        }
+        if (!json_value(s, i)) return false;
+        if (i >= s.size()) return false;
+        if (s[i] == close) { i++; return true; }
+        if (s[i++] != ',') return false;
+    }
+}
+
+bool json_value(const std::string& s, size_t& i)
+{
+    json_space(s, i);
+    if (i >= s.size()) return false;
+    bool valid;
+    if (s[i] == '{') valid = json_list(s, i, '}', true);
+    else if (s[i] == '[') valid = json_list(s, i, ']', false);
+    else if (s[i] == '"') valid = json_string(s, i);
+    else if (s.compare(i, 4, "true") == 0 || s.compare(i, 4, "null") == 0) { i += 4; valid = true; }
+    else if (s.compare(i, 5, "false") == 0) { i += 5; valid = true; }
+    else valid = json_number(s, i);
+    json_space(s, i);
+    return valid;
+}
+
+// whole text is one JSON value
+bool json_valid(const std::string& s)
+{
+    size_t i = 0;
+    return json_value(s, i) && i == s.size();
+}
+
+void test_reporter_trace()
+{
+    using _TYPE = double;
+    const int NBIT = 32;
+
+    std::ostringstream report;
+    uint64_t dropped = 0;
+    {
+        galgo::Reporter reporter(report, galgo::ReportFormat::JSON);
+        galgo::TraceLog trace("galgo_trace.json", 8);
+
+        galgo::ConfigInfo<_TYPE> config;
+        config.Objective = rastriginObjective<_TYPE>::Objective;
+        config.popsize = 100;
+        config.nbgen = 50;
+        config.genstep = 10;
+        config.pipeline_ratio = 0.3;
+        config.output = false;
+        config.reporter = &reporter;
+        config.trace = &trace;
+
+        galgo::Parameter<_TYPE, NBIT> par1({ (_TYPE)-4.0,(_TYPE)5.0 });
+        galgo::Parameter<_TYPE, NBIT> par2({ (_TYPE)-4.0,(_TYPE)5.0 });
+        galgo::Parameter<_TYPE, NBIT> par3({ (_TYPE)-4.0,(_TYPE)5.0 });
+        galgo::GeneticAlgorithm<_TYPE> ga(config, par1, par2, par3);
+        ga.run();
+        dropped = trace.dropped();
+    }
+
+    std::cout << std::endl;
+    std::cout << "JSON reporter and trace log (Rastrigin function, trace ring buffers of 8 events)\n";
+    std::istringstream lines(report.str());
+    std::string line;
+    int nbline = 0;
+    int nbvalid = 0;
+    while (std::getline(lines, line)) {
+        std::cout << " " << line << "\n";
+        nbline++;
+        if (json_valid(line)) nbvalid++;
+    }
+    std::cout << " Report: " << nbline << " lines, " << (nbline > 0 && nbvalid == nbline ? "valid JSON" : "INVALID JSON") << "\n";
+
+    std::vector<char> data;
+    galgo::ReadCheckpoint("galgo_trace.json", data);
+    std::string json(data.begin(), data.end());
+    size_t nbevent = 0;
+    for (size_t pos = json.find("\"ph\":\"X\""); pos != std::string::npos; pos = json.find("\"ph\":\"X\"", pos + 1)) nbevent++;
+    std::cout << " Trace: " << nbevent << " events, " << dropped << " dropped, " << (json_valid(json) ? "valid JSON" : "INVALID JSON") << "\n";
+    std::remove("galgo_trace.json");
+}
 #endif